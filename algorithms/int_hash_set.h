@@ -0,0 +1,144 @@
+#ifndef ALGORITHMS_INT_HASH_SET_H
+#define ALGORITHMS_INT_HASH_SET_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace int_hash_set {
+/*
+  Hash set for non-negative integer keys whose hash values and equality are
+  not defined by the integers themselves but by the data they refer to. The
+  main use case is the state registry: the keys are StateIDs, and two keys are
+  equal iff the states stored for them are equal.
+
+  We use open addressing with linear probing. Each bucket stores a key
+  together with the upper 32 bits of its 64-bit hash value (8 bytes in
+  total). The stored hash serves two purposes:
+
+  - The bucket index is taken from the highest bits of the stored hash. This
+    allows us to grow the table without computing any hash values again,
+    which would require touching the data of every key.
+  - Most non-matching keys on a probe sequence can be rejected by comparing
+    stored hashes, without calling Equal (which dereferences the key's data).
+
+  Keys are never removed, so we need no tombstones.
+*/
+template<typename Hasher, typename Equal>
+class IntHashSet {
+public:
+    using KeyType = int;
+
+private:
+    static const KeyType empty_bucket_key = -1;
+    static const int min_num_bits = 4;
+    static const int max_num_bits = 32;
+
+    struct Bucket {
+        KeyType key;
+        std::uint32_t hash;
+
+        Bucket() : key(empty_bucket_key), hash(0) {
+        }
+
+        bool empty() const {
+            return key == empty_bucket_key;
+        }
+    };
+
+    Hasher hasher;
+    Equal equal;
+    std::vector<Bucket> buckets;
+    int num_bits;
+    int num_entries;
+
+    static std::uint32_t get_stored_hash(std::uint64_t hash) {
+        return static_cast<std::uint32_t>(hash >> 32);
+    }
+
+    std::size_t get_bucket(std::uint32_t hash) const {
+        return hash >> (32 - num_bits);
+    }
+
+    std::size_t get_mask() const {
+        return buckets.size() - 1;
+    }
+
+    bool is_too_full(int entries) const {
+        // Maximum load factor is 3/4.
+        return 4 * static_cast<std::size_t>(entries) > 3 * buckets.size();
+    }
+
+    std::size_t find_free_bucket(std::uint32_t hash) const {
+        std::size_t mask = get_mask();
+        std::size_t index = get_bucket(hash);
+        while (!buckets[index].empty()) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void grow() {
+        assert(num_bits < max_num_bits);
+        std::vector<Bucket> old_buckets;
+        old_buckets.swap(buckets);
+        ++num_bits;
+        buckets.resize(static_cast<std::size_t>(1) << num_bits);
+        for (const Bucket &bucket : old_buckets) {
+            if (!bucket.empty()) {
+                buckets[find_free_bucket(bucket.hash)] = bucket;
+            }
+        }
+    }
+
+public:
+    IntHashSet(const Hasher &hasher, const Equal &equal)
+        : hasher(hasher),
+          equal(equal),
+          buckets(static_cast<std::size_t>(1) << min_num_bits),
+          num_bits(min_num_bits),
+          num_entries(0) {
+    }
+
+    /*
+      Insert the key if no equal key is present. Return the key that is
+      stored in the set afterwards and whether it was newly inserted.
+    */
+    std::pair<KeyType, bool> insert(KeyType key) {
+        assert(key >= 0);
+        if (is_too_full(num_entries + 1)) {
+            grow();
+        }
+        std::uint32_t hash = get_stored_hash(hasher(key));
+        std::size_t mask = get_mask();
+        std::size_t index = get_bucket(hash);
+        while (!buckets[index].empty()) {
+            const Bucket &bucket = buckets[index];
+            if (bucket.hash == hash && equal(bucket.key, key)) {
+                return {bucket.key, false};
+            }
+            index = (index + 1) & mask;
+        }
+        buckets[index].key = key;
+        buckets[index].hash = hash;
+        ++num_entries;
+        return {key, true};
+    }
+
+    int size() const {
+        return num_entries;
+    }
+
+    std::size_t capacity() const {
+        return buckets.size();
+    }
+
+    std::size_t get_num_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+};
+}
+
+#endif
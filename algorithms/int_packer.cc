@@ -0,0 +1,142 @@
+#include "int_packer.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace int_packer {
+/*
+  We are using fixed-size 32-bit bins below. It would be possible to
+  use larger bins (e.g. 64 bits), but we have found 32-bit bins to give
+  better cache behavior for the typical state sizes.
+*/
+static const int BITS_PER_BIN = sizeof(IntPacker::Bin) * 8;
+
+static IntPacker::Bin get_bit_mask(int from, int to) {
+    // Return mask with all bits in the range [from, to) set to 1.
+    assert(from >= 0 && to >= from && to <= BITS_PER_BIN);
+    int length = to - from;
+    if (length == BITS_PER_BIN) {
+        // 1U << 32 has undefined behaviour on 32-bit platforms.
+        assert(from == 0 && to == BITS_PER_BIN);
+        return ~IntPacker::Bin(0);
+    } else {
+        return ((IntPacker::Bin(1) << length) - 1) << from;
+    }
+}
+
+static int get_bit_size_for_range(int range) {
+    /*
+      We reserve at least one bit even for variables with a single value.
+      Otherwise they would never be assigned to a bin by the greedy packing
+      below, and a task consisting only of such variables would have no bins.
+    */
+    int num_bits = 1;
+    while ((1U << num_bits) < static_cast<unsigned int>(range))
+        ++num_bits;
+    return num_bits;
+}
+
+class IntPacker::VariableInfo {
+    int range;
+    int bin_index;
+    int shift;
+    Bin read_mask;
+    Bin clear_mask;
+public:
+    VariableInfo(int range_, int bin_index_, int shift_)
+        : range(range_), bin_index(bin_index_), shift(shift_) {
+        int bit_size = get_bit_size_for_range(range);
+        read_mask = get_bit_mask(shift, shift + bit_size);
+        clear_mask = ~read_mask;
+    }
+
+    VariableInfo()
+        : range(0), bin_index(-1), shift(0), read_mask(0), clear_mask(0) {
+        // Default constructor needed for resize() in pack_bins.
+    }
+
+    int get(const Bin *buffer) const {
+        return (buffer[bin_index] & read_mask) >> shift;
+    }
+
+    void set(Bin *buffer, int value) const {
+        assert(value >= 0 && value < range);
+        Bin &bin = buffer[bin_index];
+        bin = (bin & clear_mask) | (value << shift);
+    }
+};
+
+IntPacker::IntPacker(const vector<int> &ranges) : num_bins(0) {
+    pack_bins(ranges);
+}
+
+IntPacker::~IntPacker() {
+}
+
+int IntPacker::get(const Bin *buffer, int var) const {
+    return var_infos[var].get(buffer);
+}
+
+void IntPacker::set(Bin *buffer, int var, int value) const {
+    var_infos[var].set(buffer, value);
+}
+
+void IntPacker::pack_bins(const vector<int> &ranges) {
+    assert(var_infos.empty());
+
+    int num_vars = ranges.size();
+    var_infos.resize(num_vars);
+
+    // bits_to_vars[k] contains all variables that require exactly k
+    // bits to encode. Once a variable is packed into a bin, it is
+    // removed from this index.
+    // Loop over the variables in reverse order to prefer variables with
+    // low indices in case of ties. This might increase cache-locality.
+    vector<vector<int>> bits_to_vars(BITS_PER_BIN + 1);
+    for (int var = num_vars - 1; var >= 0; --var) {
+        int bits = get_bit_size_for_range(ranges[var]);
+        assert(bits <= BITS_PER_BIN);
+        bits_to_vars[bits].push_back(var);
+    }
+
+    int packed_vars = 0;
+    while (packed_vars != num_vars)
+        packed_vars += pack_one_bin(ranges, bits_to_vars);
+}
+
+int IntPacker::pack_one_bin(
+    const vector<int> &ranges, vector<vector<int>> &bits_to_vars) {
+    // Returns the number of variables added to the bin. We pack each
+    // bin with a greedy strategy, always adding the largest variable
+    // that still fits.
+
+    ++num_bins;
+    int bin_index = num_bins - 1;
+    int used_bits = 0;
+    int num_vars_in_bin = 0;
+
+    while (true) {
+        // Determine size of largest variable that still fits into the bin.
+        int bits = BITS_PER_BIN - used_bits;
+        while (bits > 0 && bits_to_vars[bits].empty())
+            --bits;
+
+        if (bits == 0) {
+            // No more variables fit into the bin.
+            // (This also happens when all variables have been packed.)
+            return num_vars_in_bin;
+        }
+
+        // We can pack another variable of size bits into the bin.
+        // Remove the variable from bits_to_vars and add it to the bin.
+        vector<int> &best_fit_vars = bits_to_vars[bits];
+        int var = best_fit_vars.back();
+        best_fit_vars.pop_back();
+
+        var_infos[var] = VariableInfo(ranges[var], bin_index, used_bits);
+        used_bits += bits;
+        ++num_vars_in_bin;
+    }
+}
+}
@@ -0,0 +1,224 @@
+#ifndef ALGORITHMS_SEGMENTED_VECTOR_H
+#define ALGORITHMS_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/*
+  SegmentedVector is a vector-like class with the following advantages over
+  vector:
+    1. Resizing has no memory spike. (*)
+    2. Should work more nicely with fragmented memory because the data is
+       stored in fixed-size chunks ("segments") that need not be adjacent.
+    3. References to elements are never invalidated by growing the vector.
+
+  (*) Resizing a vector temporarily needs 1.5 or 2 times the memory of the
+  old vector because the old and the new data have to coexist while the
+  contents are copied. SegmentedVector only allocates one new segment at a
+  time.
+
+  The price we pay for this is one extra indirection on every access. The
+  segment size is chosen such that a segment fits into a few pages, so the
+  directory of segment pointers is small and stays in cache.
+
+  SegmentedArrayVector is a variation that stores fixed-size arrays of
+  elements (e.g. states) contiguously. All arrays must have the same size,
+  which is fixed at construction.
+
+  Both classes only support trivially copyable element types because they
+  are meant for large amounts of plain per-state data.
+*/
+
+namespace segmented_vector {
+/*
+  Segments hold raw memory: entries are trivially copyable, so we construct
+  them in place on push_back and never need to destroy them. This also allows
+  entry types without a default constructor (e.g. StateID).
+*/
+struct SegmentDeleter {
+    void operator()(void *segment) const {
+        ::operator delete(segment);
+    }
+};
+
+template<class T>
+using Segment = std::unique_ptr<T, SegmentDeleter>;
+
+template<class T>
+Segment<T> allocate_segment(size_t num_elements) {
+    void *memory = ::operator new(num_elements * sizeof(T));
+    return Segment<T>(static_cast<T *>(memory));
+}
+
+template<class Entry>
+class SegmentedVector {
+    static_assert(std::is_trivially_copyable_v<Entry>);
+
+    static const size_t SEGMENT_BYTES = 8192;
+    static const size_t SEGMENT_ELEMENTS =
+        (SEGMENT_BYTES / sizeof(Entry)) >= 1 ? (SEGMENT_BYTES / sizeof(Entry))
+                                             : 1;
+
+    std::vector<Segment<Entry>> segments;
+    size_t the_size;
+
+    size_t get_segment(size_t index) const {
+        return index / SEGMENT_ELEMENTS;
+    }
+
+    size_t get_offset(size_t index) const {
+        return index % SEGMENT_ELEMENTS;
+    }
+
+    void add_segment() {
+        segments.push_back(allocate_segment<Entry>(SEGMENT_ELEMENTS));
+    }
+
+public:
+    SegmentedVector() : the_size(0) {
+    }
+
+    SegmentedVector(const SegmentedVector &) = delete;
+    SegmentedVector &operator=(const SegmentedVector &) = delete;
+
+    Entry &operator[](size_t index) {
+        assert(index < the_size);
+        return segments[get_segment(index)].get()[get_offset(index)];
+    }
+
+    const Entry &operator[](size_t index) const {
+        assert(index < the_size);
+        return segments[get_segment(index)].get()[get_offset(index)];
+    }
+
+    size_t size() const {
+        return the_size;
+    }
+
+    void push_back(const Entry &entry) {
+        size_t segment = get_segment(the_size);
+        if (segment == segments.size()) {
+            add_segment();
+        }
+        new (segments[segment].get() + get_offset(the_size)) Entry(entry);
+        ++the_size;
+    }
+
+    void pop_back() {
+        assert(the_size > 0);
+        --the_size;
+        /*
+          We do not release the memory of a segment that becomes empty because
+          pop_back is typically followed by push_back.
+        */
+    }
+
+    /*
+      Grow to new_size, filling new positions with entry. Shrinking is not
+      supported because we never need it.
+    */
+    void resize(size_t new_size, const Entry &entry) {
+        assert(new_size >= the_size);
+        while (the_size < new_size) {
+            push_back(entry);
+        }
+    }
+
+    void clear() {
+        segments.clear();
+        the_size = 0;
+    }
+
+    size_t get_num_bytes() const {
+        return segments.size() * SEGMENT_ELEMENTS * sizeof(Entry) +
+               segments.capacity() * sizeof(Segment<Entry>);
+    }
+};
+
+
+template<class Element>
+class SegmentedArrayVector {
+    static_assert(std::is_trivially_copyable_v<Element>);
+
+    static const size_t SEGMENT_BYTES = 8192;
+
+    const size_t elements_per_array;
+    const size_t arrays_per_segment;
+    const size_t elements_per_segment;
+
+    std::vector<Segment<Element>> segments;
+    size_t the_size;
+
+    size_t get_segment(size_t index) const {
+        return index / arrays_per_segment;
+    }
+
+    size_t get_offset(size_t index) const {
+        return (index % arrays_per_segment) * elements_per_array;
+    }
+
+    void add_segment() {
+        segments.push_back(allocate_segment<Element>(elements_per_segment));
+    }
+
+public:
+    explicit SegmentedArrayVector(size_t elements_per_array)
+        : elements_per_array(elements_per_array),
+          arrays_per_segment(std::max(
+              SEGMENT_BYTES / (std::max<size_t>(elements_per_array, 1) *
+                               sizeof(Element)),
+              size_t(1))),
+          elements_per_segment(elements_per_array * arrays_per_segment),
+          the_size(0) {
+    }
+
+    SegmentedArrayVector(const SegmentedArrayVector &) = delete;
+    SegmentedArrayVector &operator=(const SegmentedArrayVector &) = delete;
+
+    Element *operator[](size_t index) {
+        assert(index < the_size);
+        return segments[get_segment(index)].get() + get_offset(index);
+    }
+
+    const Element *operator[](size_t index) const {
+        assert(index < the_size);
+        return segments[get_segment(index)].get() + get_offset(index);
+    }
+
+    size_t size() const {
+        return the_size;
+    }
+
+    void push_back(const Element *entry) {
+        size_t segment = get_segment(the_size);
+        if (segment == segments.size()) {
+            add_segment();
+        }
+        Element *dest = segments[segment].get() + get_offset(the_size);
+        std::uninitialized_copy(entry, entry + elements_per_array, dest);
+        ++the_size;
+    }
+
+    void pop_back() {
+        assert(the_size > 0);
+        --the_size;
+    }
+
+    void clear() {
+        segments.clear();
+        the_size = 0;
+    }
+
+    size_t get_num_bytes() const {
+        return segments.size() * elements_per_segment * sizeof(Element) +
+               segments.capacity() * sizeof(Segment<Element>);
+    }
+};
+}
+
+#endif
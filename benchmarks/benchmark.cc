@@ -0,0 +1,90 @@
+#include "benchmark.h"
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+atomic<long long> num_allocations(0);
+
+vector<pair<string, benchmark::BenchmarkFunction>> &get_benchmarks() {
+    static vector<pair<string, benchmark::BenchmarkFunction>> benchmarks;
+    return benchmarks;
+}
+
+void *allocate(size_t size, size_t alignment) {
+    num_allocations.fetch_add(1, memory_order_relaxed);
+    size = max<size_t>(size, 1);
+    void *memory;
+    if (alignment <= alignof(max_align_t)) {
+        memory = malloc(size);
+    } else {
+        // aligned_alloc needs a multiple of the alignment as size.
+        memory = aligned_alloc(
+            alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+}
+
+void *operator new(size_t size) {
+    return allocate(size, alignof(max_align_t));
+}
+
+void *operator new(size_t size, align_val_t alignment) {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, align_val_t) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t, align_val_t) noexcept {
+    free(memory);
+}
+
+namespace benchmark {
+Benchmark::Benchmark(const string &name, BenchmarkFunction run) {
+    get_benchmarks().emplace_back(name, run);
+}
+
+long long get_num_allocations() {
+    return num_allocations.load(memory_order_relaxed);
+}
+}
+
+int main(int argc, char **argv) {
+    vector<string> names(argv + 1, argv + argc);
+    vector<pair<string, benchmark::BenchmarkFunction>> &benchmarks =
+        get_benchmarks();
+    sort(benchmarks.begin(), benchmarks.end());
+    for (const auto &[name, run] : benchmarks) {
+        if (!names.empty() &&
+            find(names.begin(), names.end(), name) == names.end()) {
+            continue;
+        }
+        utils::g_log << "=== " << name << " ===" << '\n';
+        run();
+        utils::g_log << '\n';
+        utils::flush_log();
+    }
+}
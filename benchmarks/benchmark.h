@@ -0,0 +1,53 @@
+#ifndef BENCHMARKS_BENCHMARK_H
+#define BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <string>
+
+/*
+  Micro-benchmarks for the performance-critical parts of the planner. They
+  are built into a separate executable with "make run_benchmarks".
+
+  Each benchmark is a function that prints its own results to utils::g_log
+  and registers itself with a Benchmark object in an anonymous namespace:
+
+    benchmark::Benchmark _benchmark("int_packer", run_benchmark);
+
+  run_benchmarks runs all registered benchmarks, or only the ones whose
+  names are given on the command line.
+*/
+namespace benchmark {
+using BenchmarkFunction = void (*)();
+
+class Benchmark {
+public:
+    Benchmark(const std::string &name, BenchmarkFunction run);
+};
+
+/*
+  Number of calls of the global operator new since the program started.
+  The benchmark executable replaces operator new to count them.
+*/
+long long get_num_allocations();
+
+// Return the number of seconds that calling f takes.
+template<typename Function>
+double measure_seconds(const Function &f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/*
+  Make the compiler assume that value is used, so that it does not remove
+  the computation of value.
+*/
+template<typename T>
+void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+}
+
+#endif
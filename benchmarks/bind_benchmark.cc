@@ -0,0 +1,119 @@
+#include "benchmark.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../tasks/explicit_task.h"
+#include "../utils/arena.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+  Bind a component DAG with 10000 evaluators to a task and report the time
+  and the number of allocations, with and without an arena and for binding
+  it again with the same cache. The DAG consists of layers of NODES_PER_LAYER
+  evaluators, each of which uses NUM_CHILDREN random evaluators of the layer
+  below. Its root uses all evaluators of the top layer.
+*/
+namespace {
+const int NUM_LAYERS = 10;
+const int NODES_PER_LAYER = 1000;
+const int NUM_CHILDREN = 3;
+
+using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
+
+// An evaluator that bind-time folding cannot merge with its children.
+class MaxEvaluator final : public Evaluator {
+    vector<shared_ptr<Evaluator>> evals;
+protected:
+    int compute_value(StateID state_id) override {
+        int result = 0;
+        for (const shared_ptr<Evaluator> &eval : evals) {
+            result = max(result, eval->evaluate(state_id));
+        }
+        return result;
+    }
+public:
+    MaxEvaluator(
+        const shared_ptr<AbstractTask> &task,
+        const vector<shared_ptr<Evaluator>> &evals,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), evals(evals) {
+    }
+
+    void dump() override {
+    }
+};
+
+EvaluatorComponent create_dag() {
+    mt19937 rng(2024);
+    uniform_int_distribution<int> child_index(0, NODES_PER_LAYER - 1);
+    vector<EvaluatorComponent> layer;
+    for (int i = 0; i < NODES_PER_LAYER; ++i) {
+        layer.push_back(
+            make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+                tuple(i, "leaf", utils::Verbosity::SILENT)));
+    }
+    for (int depth = 1; depth < NUM_LAYERS; ++depth) {
+        vector<EvaluatorComponent> next_layer;
+        for (int i = 0; i < NODES_PER_LAYER; ++i) {
+            vector<EvaluatorComponent> children;
+            for (int j = 0; j < NUM_CHILDREN; ++j) {
+                children.push_back(layer[child_index(rng)]);
+            }
+            next_layer.push_back(
+                make_shared_component<MaxEvaluator, Evaluator>(
+                    tuple(children, "max", utils::Verbosity::SILENT)));
+        }
+        layer = move(next_layer);
+    }
+    return make_shared_component<MaxEvaluator, Evaluator>(
+        tuple(layer, "root", utils::Verbosity::SILENT));
+}
+
+void report(const char *name, double seconds, long long num_allocations) {
+    utils::g_log << "  " << name << ": " << seconds * 1e3 << " ms, "
+                 << num_allocations << " allocations" << '\n';
+}
+
+void run_benchmark() {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    EvaluatorComponent root = create_dag();
+    utils::g_log << "Binding " << NUM_LAYERS * NODES_PER_LAYER + 1
+                 << " evaluators:" << '\n';
+
+    for (bool use_arena : {false, true}) {
+        Cache cache;
+        if (use_arena) {
+            cache.set_arena(make_shared<utils::Arena>());
+        }
+        shared_ptr<Evaluator> bound_root;
+        long long allocations_before = benchmark::get_num_allocations();
+        double seconds = benchmark::measure_seconds([&] {
+            bound_root = root->bind_task(task, cache);
+        });
+        report(use_arena ? "arena" : "heap", seconds,
+               benchmark::get_num_allocations() - allocations_before);
+
+        // All components are found in the cache.
+        allocations_before = benchmark::get_num_allocations();
+        seconds = benchmark::measure_seconds([&] {
+            benchmark::do_not_optimize(root->bind_task(task, cache).get());
+        });
+        report(use_arena ? "arena, bound again" : "heap, bound again",
+               seconds, benchmark::get_num_allocations() - allocations_before);
+    }
+}
+
+benchmark::Benchmark _benchmark("bind", run_benchmark);
+}
@@ -0,0 +1,129 @@
+#include "benchmark.h"
+
+#include "../evaluator.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/linear_combination_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../tasks/explicit_task.h"
+#include "../utils/logging.h"
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/*
+  Measure what EagerSearch gains from calling its f-evaluator through the
+  final class instead of the Evaluator interface (see
+  EagerSearch::specialize_search_loop). Like the search, we evaluate the
+  successors of one expansion at a time with one batch call. The leaves look
+  up values in a table, so the time is dominated by the calls.
+*/
+namespace {
+const int NUM_BATCHES = 2000000;
+const int BATCH_SIZE = 4;
+const int NUM_STATES = 1024;
+
+class TableEvaluator final : public Evaluator {
+    vector<int> values;
+protected:
+    int compute_value(StateID state_id) override {
+        return values[state_id.get_value()];
+    }
+public:
+    TableEvaluator(const shared_ptr<AbstractTask> &task, int factor)
+        : Evaluator(task, "table", utils::Verbosity::SILENT),
+          values(NUM_STATES) {
+        for (int i = 0; i < NUM_STATES; ++i) {
+            values[i] = (i * factor) % 97;
+        }
+    }
+
+    void dump() override {
+    }
+};
+
+/*
+  Evaluate batches through a reference of type EvaluatorType. The function
+  is not inlined, so that the compiler cannot see the dynamic type of the
+  evaluator when EvaluatorType is Evaluator.
+*/
+template<class EvaluatorType>
+[[gnu::noinline]] double evaluate_batches(EvaluatorType &evaluator) {
+    vector<StateID> batch;
+    vector<int> values(BATCH_SIZE);
+    long long checksum = 0;
+    double seconds = benchmark::measure_seconds([&] {
+        for (int i = 0; i < NUM_BATCHES; ++i) {
+            batch.clear();
+            for (int j = 0; j < BATCH_SIZE; ++j) {
+                batch.emplace_back((i * BATCH_SIZE + j) % NUM_STATES);
+            }
+            evaluator.evaluate(batch, values);
+            checksum += values[0];
+        }
+    });
+    benchmark::do_not_optimize(checksum);
+    return seconds;
+}
+
+template<class EvaluatorType>
+void compare(const char *name, EvaluatorType &evaluator) {
+    double seconds_virtual =
+        evaluate_batches<Evaluator>(static_cast<Evaluator &>(evaluator));
+    double seconds_final = evaluate_batches<EvaluatorType>(evaluator);
+    utils::g_log << "  " << name << ": "
+                 << seconds_virtual * 1e9 / NUM_BATCHES
+                 << " ns per batch through Evaluator, "
+                 << seconds_final * 1e9 / NUM_BATCHES
+                 << " ns through the final class" << '\n';
+}
+
+void compare_const(const_evaluator::ConstEvaluator &evaluator) {
+    double seconds_virtual = evaluate_batches<Evaluator>(evaluator);
+    // The specialized search loop only reads the constant.
+    vector<int> values(BATCH_SIZE);
+    long long checksum = 0;
+    double seconds_final = benchmark::measure_seconds([&] {
+        for (int i = 0; i < NUM_BATCHES; ++i) {
+            for (int &value : values) {
+                value = evaluator.get_value();
+            }
+            benchmark::do_not_optimize(values.data());
+            checksum += values[0];
+        }
+    });
+    benchmark::do_not_optimize(checksum);
+    utils::g_log << "  ConstEvaluator: "
+                 << seconds_virtual * 1e9 / NUM_BATCHES
+                 << " ns per batch through Evaluator, "
+                 << seconds_final * 1e9 / NUM_BATCHES
+                 << " ns through the final class" << '\n';
+}
+
+void run_benchmark() {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    auto g = make_shared<TableEvaluator>(task, 3);
+    auto h = make_shared<TableEvaluator>(task, 7);
+    const utils::Verbosity silent = utils::Verbosity::SILENT;
+
+    utils::g_log << NUM_BATCHES << " batches of " << BATCH_SIZE
+                 << " states:" << '\n';
+    const_evaluator::ConstEvaluator const_eval(task, 5, "const", silent);
+    compare_const(const_eval);
+    // g + 5 * h, as bind-time folding produces it for weighted A*.
+    LinearCombinationEvaluator linear_eval(
+        task, 0, {1, 5}, {g, h}, "linear", silent);
+    compare("LinearCombinationEvaluator", linear_eval);
+    SumEvaluator sum_eval(task, {g, h}, "sum", silent);
+    compare("SumEvaluator", sum_eval);
+    WeightedEvaluator weighted_eval(task, 5, h, "weighted", silent);
+    compare("WeightedEvaluator", weighted_eval);
+}
+
+benchmark::Benchmark _benchmark("evaluator_devirtualization", run_benchmark);
+}
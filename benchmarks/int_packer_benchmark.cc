@@ -0,0 +1,83 @@
+#include "benchmark.h"
+
+#include "../algorithms/int_packer.h"
+#include "../utils/logging.h"
+
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/*
+  Compare writing and reading all variables of many states in the packed
+  layout of int_packer::IntPacker with an unpacked layout of one int per
+  variable.
+*/
+namespace {
+const int NUM_STATES = 100000;
+const int NUM_VARIABLES = 64;
+const int NUM_ROUNDS = 10;
+
+void report(const char *layout, double seconds, int bytes_per_state) {
+    double num_operations =
+        static_cast<double>(NUM_ROUNDS) * NUM_STATES * NUM_VARIABLES;
+    utils::g_log << layout << ": " << seconds * 1e9 / num_operations
+                 << " ns per get and set, " << bytes_per_state
+                 << " bytes per state" << '\n';
+}
+
+void run_benchmark() {
+    // Domain sizes between 2 and 16, as in typical planning tasks.
+    mt19937 rng(2024);
+    vector<int> domain_sizes(NUM_VARIABLES);
+    for (int &domain_size : domain_sizes) {
+        domain_size = uniform_int_distribution<int>(2, 16)(rng);
+    }
+    vector<int> values(NUM_VARIABLES);
+
+    int_packer::IntPacker packer(domain_sizes);
+    int num_bins = packer.get_num_bins();
+    vector<int_packer::IntPacker::Bin> packed(NUM_STATES * num_bins);
+    long long packed_sum = 0;
+    double packed_seconds = benchmark::measure_seconds([&] {
+        for (int round = 0; round < NUM_ROUNDS; ++round) {
+            for (int state = 0; state < NUM_STATES; ++state) {
+                int_packer::IntPacker::Bin *buffer =
+                    packed.data() + state * num_bins;
+                for (int var = 0; var < NUM_VARIABLES; ++var) {
+                    packer.set(buffer, var, (state + var) % domain_sizes[var]);
+                }
+                for (int var = 0; var < NUM_VARIABLES; ++var) {
+                    packed_sum += packer.get(buffer, var);
+                }
+            }
+        }
+    });
+    benchmark::do_not_optimize(packed_sum);
+
+    vector<int> unpacked(NUM_STATES * NUM_VARIABLES);
+    long long unpacked_sum = 0;
+    double unpacked_seconds = benchmark::measure_seconds([&] {
+        for (int round = 0; round < NUM_ROUNDS; ++round) {
+            for (int state = 0; state < NUM_STATES; ++state) {
+                int *buffer = unpacked.data() + state * NUM_VARIABLES;
+                for (int var = 0; var < NUM_VARIABLES; ++var) {
+                    buffer[var] = (state + var) % domain_sizes[var];
+                }
+                for (int var = 0; var < NUM_VARIABLES; ++var) {
+                    unpacked_sum += buffer[var];
+                }
+            }
+        }
+    });
+    benchmark::do_not_optimize(unpacked_sum);
+
+    utils::g_log << NUM_STATES << " states with " << NUM_VARIABLES
+                 << " variables" << '\n';
+    report("packed", packed_seconds,
+           num_bins * sizeof(int_packer::IntPacker::Bin));
+    report("unpacked", unpacked_seconds, NUM_VARIABLES * sizeof(int));
+}
+
+benchmark::Benchmark _benchmark("int_packer", run_benchmark);
+}
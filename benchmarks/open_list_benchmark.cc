@@ -0,0 +1,181 @@
+#include "benchmark.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include "../open_lists/radix_heap_open_list.h"
+#include "../open_lists/tiebreaking_open_list.h"
+#include "../tasks/explicit_task.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*
+  Compare open lists with a std::priority_queue baseline on the access
+  pattern of a best-first search: remove an entry with minimal key and
+  insert its successors as one batch, whose keys are the key of the removed
+  entry plus a small random increment. Keys are looked up in a table by an
+  evaluator, so all open lists pay the same for computing keys.
+*/
+namespace {
+const int NUM_EXPANSIONS = 1000000;
+const int NUM_SUCCESSORS = 4;
+
+class KeyEvaluator final : public Evaluator {
+    const vector<int> &keys;
+protected:
+    int compute_value(StateID state_id) override {
+        return keys[state_id.get_value()];
+    }
+public:
+    KeyEvaluator(
+        const shared_ptr<AbstractTask> &task, const vector<int> &keys)
+        : Evaluator(task, "key", utils::Verbosity::SILENT), keys(keys) {
+    }
+
+    void dump() override {
+    }
+};
+
+/*
+  Key increments of the generated states, in the order in which they are
+  generated. Increments are 0, 1 or 2 times scale. On average, less than one
+  successor per expansion has the same key as its parent, so the search
+  does not get stuck on one key. With decreases, one in ten increments is
+  -scale instead, like the keys of an inconsistent heuristic.
+*/
+vector<int> generate_increments(int scale, bool decreases) {
+    mt19937 rng(2024);
+    discrete_distribution<int> increment({2, 5, 3});
+    uniform_int_distribution<int> decrease(0, 9);
+    vector<int> increments(NUM_EXPANSIONS * NUM_SUCCESSORS);
+    for (int &value : increments) {
+        value = increment(rng) * scale;
+        if (decreases && decrease(rng) == 0) {
+            value = -scale;
+        }
+    }
+    return increments;
+}
+
+/*
+  Run the search pattern with the given operations and report the time per
+  inserted entry. The key of state i + 1 is the key of its parent plus
+  increments[i].
+*/
+void run_workload(
+    const char *name, const vector<int> &increments, vector<int> &keys,
+    const function<void(span<const StateID>)> &insert,
+    const function<StateID()> &remove_min) {
+    keys.assign(1, 0);
+    keys.reserve(increments.size() + 1);
+    vector<StateID> successors;
+    long long checksum = 0;
+    double seconds = benchmark::measure_seconds([&] {
+        insert(span<const StateID>(vector<StateID>{StateID(0)}));
+        for (int i = 0; i < NUM_EXPANSIONS; ++i) {
+            StateID id = remove_min();
+            int key = keys[id.get_value()];
+            checksum += key;
+            successors.clear();
+            for (int j = 0; j < NUM_SUCCESSORS; ++j) {
+                successors.emplace_back(keys.size());
+                keys.push_back(max(key + increments[keys.size() - 1], 0));
+            }
+            insert(successors);
+        }
+    });
+    utils::g_log << "  " << name << ": "
+                 << seconds * 1e9 / (NUM_EXPANSIONS * (NUM_SUCCESSORS + 1))
+                 << " ns per insertion or removal (checksum " << checksum
+                 << ")" << '\n';
+}
+
+void run_priority_queue(
+    const vector<int> &increments, vector<int> &keys, Evaluator &evaluator) {
+    // Order by key and then by insertion order, like the open lists.
+    using Entry = pair<pair<int, long long>, StateID>;
+    struct Compare {
+        bool operator()(const Entry &lhs, const Entry &rhs) const {
+            return lhs.first > rhs.first;
+        }
+    };
+    priority_queue<Entry, vector<Entry>, Compare> queue;
+    long long num_insertions = 0;
+    vector<int> values;
+    run_workload(
+        "std::priority_queue", increments, keys,
+        [&](span<const StateID> ids) {
+            values.resize(ids.size());
+            evaluator.evaluate(ids, values);
+            for (size_t i = 0; i < ids.size(); ++i) {
+                queue.push({{values[i], num_insertions++}, ids[i]});
+            }
+        },
+        [&] {
+            StateID id = queue.top().second;
+            queue.pop();
+            return id;
+        });
+}
+
+void run_open_list(
+    const char *name, const vector<int> &increments, vector<int> &keys,
+    StateOpenList &open_list) {
+    run_workload(
+        name, increments, keys,
+        [&](span<const StateID> ids) {open_list.insert(ids);},
+        [&] {return open_list.remove_min();});
+}
+
+void run_benchmark() {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    vector<int> keys;
+    auto evaluator = make_shared<KeyEvaluator>(task, keys);
+    TieBreakingOpenListFactory tie_breaking_factory(
+        task, {evaluator}, false, false, "tie_breaking",
+        utils::Verbosity::SILENT);
+    RadixHeapOpenListFactory radix_heap_factory(
+        task, evaluator, false, "radix_heap", utils::Verbosity::SILENT);
+
+    utils::g_log << NUM_EXPANSIONS << " expansions with " << NUM_SUCCESSORS
+                 << " successors each, key increments 0 to 2:" << '\n';
+    vector<int> increments = generate_increments(1, false);
+    run_priority_queue(increments, keys, *evaluator);
+    run_open_list(
+        "TieBreakingOpenList", increments, keys,
+        *tie_breaking_factory.create_state_open_list());
+    run_open_list(
+        "RadixHeapOpenList", increments, keys,
+        *radix_heap_factory.create_state_open_list());
+
+    // Bucket arrays indexed by keys in the millions are not an option.
+    utils::g_log << "Key increments 0 to 200000:" << '\n';
+    increments = generate_increments(100000, false);
+    run_priority_queue(increments, keys, *evaluator);
+    run_open_list(
+        "RadixHeapOpenList", increments, keys,
+        *radix_heap_factory.create_state_open_list());
+
+    // The radix heap falls back to a pairing heap after the first decrease.
+    utils::g_log << "Key increments -100000 to 200000:" << '\n';
+    increments = generate_increments(100000, true);
+    run_priority_queue(increments, keys, *evaluator);
+    run_open_list(
+        "RadixHeapOpenList", increments, keys,
+        *radix_heap_factory.create_state_open_list());
+}
+
+benchmark::Benchmark _benchmark("open_list", run_benchmark);
+}
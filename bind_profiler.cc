@@ -0,0 +1,177 @@
+#include "bind_profiler.h"
+
+#ifdef BIND_PROFILING
+#include "utils/hash.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+  Count the bytes allocated by each thread. We only count and never
+  subtract, so the numbers are the allocation volume, not the memory held.
+*/
+static thread_local size_t allocated_bytes = 0;
+
+void *operator new(size_t num_bytes) {
+    allocated_bytes += num_bytes;
+    void *memory = malloc(num_bytes ? num_bytes : 1);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace bind_profiler {
+struct Node {
+    const void *component = nullptr;
+    const void *task = nullptr;
+    bool constructed = false;
+    double wall_time = 0;
+    size_t allocated_bytes = 0;
+    vector<unique_ptr<Node>> children;
+};
+
+// Protects the tree and the type names.
+static mutex profile_mutex;
+static Node root;
+static utils::HashMap<const void *, string> type_names;
+static thread_local Node *current_node = nullptr;
+
+BindScope::BindScope(const void *component, const void *task)
+    : previous_node(current_node),
+      start_time(chrono::steady_clock::now()),
+      start_allocated_bytes(allocated_bytes) {
+    auto new_node = make_unique<Node>();
+    new_node->component = component;
+    new_node->task = task;
+    node = new_node.get();
+    {
+        lock_guard<mutex> lock(profile_mutex);
+        Node *parent = previous_node ? previous_node : &root;
+        parent->children.push_back(move(new_node));
+    }
+    current_node = node;
+}
+
+BindScope::~BindScope() {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+    node->wall_time = elapsed.count();
+    node->allocated_bytes = allocated_bytes - start_allocated_bytes;
+    current_node = previous_node;
+}
+
+ParentScope::ParentScope(Node *parent)
+    : previous_node(current_node) {
+    current_node = parent;
+}
+
+ParentScope::~ParentScope() {
+    current_node = previous_node;
+}
+
+Node *get_current_node() {
+    return current_node;
+}
+
+void record_construction(const char *mangled_type_name) {
+    if (!current_node) {
+        return;
+    }
+    current_node->constructed = true;
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(mangled_type_name, nullptr, nullptr, &status);
+    string name = status == 0 ? demangled : mangled_type_name;
+    free(demangled);
+    lock_guard<mutex> lock(profile_mutex);
+    type_names[current_node->component] = name;
+}
+
+static string get_name(const Node &node) {
+    auto it = type_names.find(node.component);
+    return it == type_names.end() ? "unknown" : it->second;
+}
+
+static double get_exclusive_time(const Node &node) {
+    double children_time = 0;
+    for (const unique_ptr<Node> &child : node.children) {
+        children_time += child->wall_time;
+    }
+    // Children bound in parallel may take longer than their parent.
+    return max(0.0, node.wall_time - children_time);
+}
+
+static void write_json_node(ostream &out, const Node &node) {
+    out << "{\"component\": \"" << get_name(node) << "\", \"address\": \""
+        << node.component << "\", \"task\": \"" << node.task
+        << "\", \"constructed\": " << (node.constructed ? "true" : "false")
+        << ", \"wall_time\": " << node.wall_time
+        << ", \"allocated_bytes\": " << node.allocated_bytes
+        << ", \"children\": [";
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        if (i > 0) {
+            out << ", ";
+        }
+        write_json_node(out, *node.children[i]);
+    }
+    out << "]}";
+}
+
+void write_json(ostream &out) {
+    lock_guard<mutex> lock(profile_mutex);
+    out << "[";
+    for (size_t i = 0; i < root.children.size(); ++i) {
+        if (i > 0) {
+            out << ",\n ";
+        }
+        write_json_node(out, *root.children[i]);
+    }
+    out << "]" << endl;
+}
+
+static void write_folded_stacks_node(
+    ostream &out, const Node &node, const string &prefix) {
+    string stack = prefix.empty() ? get_name(node)
+                                  : prefix + ";" + get_name(node);
+    if (!node.constructed) {
+        stack += " (cached)";
+    }
+    out << stack << " "
+        << static_cast<long long>(get_exclusive_time(node) * 1e6) << "\n";
+    for (const unique_ptr<Node> &child : node.children) {
+        write_folded_stacks_node(out, *child, stack);
+    }
+}
+
+void write_folded_stacks(ostream &out) {
+    lock_guard<mutex> lock(profile_mutex);
+    for (const unique_ptr<Node> &child : root.children) {
+        write_folded_stacks_node(out, *child, "");
+    }
+    out.flush();
+}
+
+void reset() {
+    lock_guard<mutex> lock(profile_mutex);
+    root.children.clear();
+    type_names.clear();
+}
+}
+#endif
@@ -0,0 +1,92 @@
+#ifndef BIND_PROFILER_H
+#define BIND_PROFILER_H
+
+/*
+  Profiling of binding components to tasks, enabled by compiling with
+  -DBIND_PROFILING. It records a tree of all bind_task calls with their
+  wall time, the bytes allocated on the binding thread and whether the
+  component was constructed or taken from the cache. The tree can be
+  written as JSON and as folded stacks for flame graph tools.
+
+  Without BIND_PROFILING, the hooks below are empty inline functions and
+  classes, so they compile to nothing.
+*/
+
+#ifdef BIND_PROFILING
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <typeinfo>
+#endif
+
+namespace bind_profiler {
+struct Node;
+
+#ifdef BIND_PROFILING
+/*
+  Record one bind_task call for the duration of the scope. Scopes on the
+  same thread nest, and ParentScope continues the tree on other threads.
+*/
+class BindScope {
+    Node *node;
+    Node *previous_node;
+    std::chrono::steady_clock::time_point start_time;
+    std::size_t start_allocated_bytes;
+public:
+    BindScope(const void *component, const void *task);
+    ~BindScope();
+
+    BindScope(const BindScope &) = delete;
+    BindScope &operator=(const BindScope &) = delete;
+};
+
+// Make parent the current node of this thread for the duration of the scope.
+class ParentScope {
+    Node *previous_node;
+public:
+    explicit ParentScope(Node *parent);
+    ~ParentScope();
+
+    ParentScope(const ParentScope &) = delete;
+    ParentScope &operator=(const ParentScope &) = delete;
+};
+
+Node *get_current_node();
+
+void record_construction(const char *mangled_type_name);
+
+// Mark the innermost bind_task call as constructing a component of type T.
+template<typename T>
+void record_construction() {
+    record_construction(typeid(T).name());
+}
+
+// The JSON tree has one object per call with the fields described above.
+void write_json(std::ostream &out);
+// One line per call stack with the exclusive time in microseconds.
+void write_folded_stacks(std::ostream &out);
+void reset();
+#else
+class BindScope {
+public:
+    BindScope(const void *, const void *) {
+    }
+};
+
+class ParentScope {
+public:
+    explicit ParentScope(Node *) {
+    }
+};
+
+inline Node *get_current_node() {
+    return nullptr;
+}
+
+template<typename T>
+void record_construction() {
+}
+#endif
+}
+
+#endif
@@ -6,7 +6,14 @@
 
 #include "plugins/plugin.h"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 class AbstractTask;
 
@@ -36,9 +43,65 @@ public:
   Base class for all task-independent components. We need this non-templated
   base class to mix components of different types in the same container.
 */
-class TaskIndependentComponentBase {
+class TaskIndependentComponentBase
+    : public std::enable_shared_from_this<TaskIndependentComponentBase> {
 public:
     virtual ~TaskIndependentComponentBase() = default;
+
+    /*
+      Return true if the bound form of this component is the same for all
+      tasks. Such components are bound only once and shared by all tasks
+      (see Cache::get_task_independent_cache).
+    */
+    virtual bool is_task_independent() const {
+        return false;
+    }
+
+    /*
+      Hash value and equality of the structure of this component, i.e., its
+      type and its arguments, where component arguments are compared by
+      structure as well. By default, components are only equal to
+      themselves.
+    */
+    virtual std::uint64_t get_structural_hash() const {
+        return utils::get_hash64(this);
+    }
+
+    virtual bool is_structurally_equal(
+        const TaskIndependentComponentBase &other) const {
+        return this == &other;
+    }
+};
+
+/*
+  Map components to a canonical representative of all structurally equal
+  components. A Cache with an interner (see Cache::set_interner) uses the
+  representative in its keys, so that structurally equal components bound
+  to the same task yield the same bound component.
+
+  The interner keeps the representatives alive, so that cache keys stay
+  valid even if the component that was interned first is released.
+*/
+class ComponentInterner {
+    std::mutex mutex;
+    utils::HashMap<
+        std::uint64_t,
+        std::vector<std::shared_ptr<const TaskIndependentComponentBase>>>
+        components_by_hash;
+public:
+    const TaskIndependentComponentBase *intern(
+        const TaskIndependentComponentBase &component) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::shared_ptr<const TaskIndependentComponentBase>>
+            &candidates = components_by_hash[component.get_structural_hash()];
+        for (const auto &candidate : candidates) {
+            if (candidate->is_structurally_equal(component)) {
+                return candidate.get();
+            }
+        }
+        candidates.push_back(component.shared_from_this());
+        return &component;
+    }
 };
 
 /*
@@ -46,23 +109,34 @@ public:
 */
 template<typename ComponentType>
 class TaskIndependentComponent : public TaskIndependentComponentBase {
+    /*
+      Bind the arguments with cache and construct the component in arena,
+      or on the heap if arena is null.
+    */
     virtual std::shared_ptr<ComponentType> create_task_specific_component(
-        const std::shared_ptr<AbstractTask> &task, Cache &cache) const = 0;
+        const std::shared_ptr<AbstractTask> &task, Cache &cache,
+        const std::shared_ptr<utils::Arena> &arena) const = 0;
 
 public:
     std::shared_ptr<ComponentType> bind_task(
         const std::shared_ptr<AbstractTask> &task, Cache &cache) const {
-        std::shared_ptr<ComponentType> component;
-        const CacheKey key = std::make_pair(this, task.get());
-        if (cache.count(key)) {
-            std::shared_ptr<TaskSpecificComponent> entry = cache.at(key);
-            component = std::dynamic_pointer_cast<ComponentType>(entry);
-            assert(component);
-        } else {
-            component = create_task_specific_component(task, cache);
-            cache.emplace(key, component);
-        }
-        return component;
+        bool task_independent = is_task_independent();
+        Cache &target_cache =
+            task_independent ? cache.get_task_independent_cache() : cache;
+        const TaskIndependentComponentBase *representative =
+            cache.get_interner() ? cache.get_interner()->intern(*this) : this;
+        const CacheKey key = std::make_pair(
+            representative, task_independent ? nullptr : task.get());
+        bind_profiler::BindScope profile_scope(key.first, key.second);
+        /*
+          The component is allocated in the arena of the cache that stores
+          it. Otherwise, shared task-independent components would keep the
+          arena of the first task that bound them alive.
+        */
+        return target_cache.get_or_create<ComponentType>(key, [&] {
+            return create_task_specific_component(
+                task, cache, target_cache.get_arena());
+        });
     }
 
     std::shared_ptr<ComponentType> bind_task(
@@ -72,6 +146,107 @@ public:
     }
 };
 
+/*
+  Customization point for replacing a freshly bound component by an
+  equivalent but cheaper one before it is stored in the Cache (e.g. folding
+  evaluator expressions). Specialize it for a component type to enable such
+  an optimization. The specialization must be visible wherever components of
+  that type are bound, so it should be declared in the header of the
+  component type.
+*/
+template<typename ComponentType>
+struct BoundComponentOptimizer {
+    static std::shared_ptr<ComponentType> optimize(
+        std::shared_ptr<ComponentType> component,
+        const std::shared_ptr<AbstractTask> &) {
+        return component;
+    }
+};
+
+/*
+  Concrete components whose bound form does not depend on the task declare
+
+    static constexpr bool task_independent = true;
+
+  This is a promise that they never use the task they are bound to, other
+  than by passing it on to their component arguments. A component is only
+  bound task-independently if all its component arguments are as well. The
+  shared bound object still refers to the task it was first bound to.
+*/
+template<typename T>
+concept DeclaresTaskIndependence = requires {
+    requires T::task_independent;
+};
+
+/*
+  Structural equality of component arguments, matching the structural hash
+  values computed with utils::feed. Like are_task_independent_recursively,
+  the overloads are declared up front.
+*/
+template<typename T>
+bool are_structurally_equal(const T &lhs, const T &rhs);
+inline bool are_structurally_equal(const char *lhs, const char *rhs);
+template<typename ComponentType>
+bool are_structurally_equal(
+    const std::shared_ptr<TaskIndependentComponent<ComponentType>> &lhs,
+    const std::shared_ptr<TaskIndependentComponent<ComponentType>> &rhs);
+template<typename T>
+bool are_structurally_equal(
+    const std::vector<T> &lhs, const std::vector<T> &rhs);
+template<typename... Args>
+bool are_structurally_equal(
+    const std::tuple<Args...> &lhs, const std::tuple<Args...> &rhs);
+
+template<typename T>
+bool are_structurally_equal(const T &lhs, const T &rhs) {
+    return lhs == rhs;
+}
+
+inline bool are_structurally_equal(const char *lhs, const char *rhs) {
+    return std::strcmp(lhs, rhs) == 0;
+}
+
+template<typename ComponentType>
+bool are_structurally_equal(
+    const std::shared_ptr<TaskIndependentComponent<ComponentType>> &lhs,
+    const std::shared_ptr<TaskIndependentComponent<ComponentType>> &rhs) {
+    return lhs == rhs || lhs->is_structurally_equal(*rhs);
+}
+
+template<typename T>
+bool are_structurally_equal(
+    const std::vector<T> &lhs, const std::vector<T> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!are_structurally_equal(lhs[i], rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename... Args>
+bool are_structurally_equal(
+    const std::tuple<Args...> &lhs, const std::tuple<Args...> &rhs) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (are_structurally_equal(std::get<Is>(lhs), std::get<Is>(rhs)) &&
+                ...);
+    }(std::index_sequence_for<Args...>());
+}
+
+namespace utils {
+// Feed component arguments by structure (see are_structurally_equal).
+template<typename ComponentType>
+void feed(
+    HashState &hash_state,
+    const std::shared_ptr<TaskIndependentComponent<ComponentType>>
+        &component) {
+    feed(hash_state, component->get_structural_hash());
+}
+}
+
 /*
   Templated implementation of a concrete component. This class stores arguments
   to construct a task-specific component (e.g. HMHeuristic, EagerSearch) in
@@ -83,16 +258,75 @@ template<typename T, ComponentTypeOf<T> ComponentType, ComponentArgsFor<T> Args>
 class AutoTaskIndependentComponent
     : public TaskIndependentComponent<ComponentType> {
     Args args;
+    bool task_independent;
+    /*
+      Only interning uses the structural hash, so we compute it on the
+      first call of get_structural_hash.
+    */
+    mutable std::once_flag structural_hash_computed;
+    mutable std::uint64_t structural_hash;
+
+    /*
+      Feed the type first, so that components of different types with equal
+      arguments get different structural hash values.
+    */
+    std::uint64_t compute_structural_hash() const {
+        utils::HashState hash_state;
+        utils::feed(
+            hash_state, static_cast<std::uint64_t>(
+                            typeid(AutoTaskIndependentComponent).hash_code()));
+        utils::feed(hash_state, args);
+        return hash_state.get_hash64();
+    }
 
     virtual std::shared_ptr<ComponentType> create_task_specific_component(
-        const std::shared_ptr<AbstractTask> &task,
-        Cache &cache) const override {
+        const std::shared_ptr<AbstractTask> &task, Cache &cache,
+        const std::shared_ptr<utils::Arena> &arena) const override {
+        bind_profiler::record_construction<T>();
         auto bound_args = bind_task_recursively(args, task, cache);
-        return plugins::make_shared_from_arg_tuples<T>(task, bound_args);
+        std::shared_ptr<ComponentType> component;
+        if (arena) {
+            component = plugins::allocate_shared_from_arg_tuples<T>(
+                utils::ArenaAllocator<T>(arena), task, move(bound_args));
+        } else {
+            component = plugins::make_shared_from_arg_tuples<T>(
+                task, move(bound_args));
+        }
+        return BoundComponentOptimizer<ComponentType>::optimize(
+            move(component), task);
     }
 
 public:
-    explicit AutoTaskIndependentComponent(Args &&args) : args(move(args)) {
+    explicit AutoTaskIndependentComponent(Args &&args)
+        : args(move(args)),
+          task_independent(
+              DeclaresTaskIndependence<T> &&
+              are_task_independent_recursively(this->args)),
+          structural_hash(0) {
+    }
+
+    virtual bool is_task_independent() const override {
+        return task_independent;
+    }
+
+    virtual std::uint64_t get_structural_hash() const override {
+        std::call_once(structural_hash_computed, [this] {
+            structural_hash = compute_structural_hash();
+        });
+        return structural_hash;
+    }
+
+    virtual bool is_structurally_equal(
+        const TaskIndependentComponentBase &other) const override {
+        if (this == &other) {
+            return true;
+        }
+        auto other_component =
+            dynamic_cast<const AutoTaskIndependentComponent *>(&other);
+        return other_component &&
+               get_structural_hash() ==
+               other_component->get_structural_hash() &&
+               are_structurally_equal(args, other_component->args);
     }
 };
 
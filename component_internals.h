@@ -1,21 +1,196 @@
 #ifndef COMPONENT_INTERNALS_H
 #define COMPONENT_INTERNALS_H
 
+#include "bind_profiler.h"
+
+#include "utils/arena.h"
 #include "utils/hash.h"
 #include "utils/language.h"
+#include "utils/thread_pool.h"
 #include "utils/tuples.h"
 
+#include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 class AbstractTask;
+class ComponentInterner;
 class TaskSpecificComponent;
 class TaskIndependentComponentBase;
 
 using CacheKey =
     std::pair<const TaskIndependentComponentBase *, const AbstractTask *>;
-using Cache = utils::HashMap<CacheKey, std::shared_ptr<TaskSpecificComponent>>;
+
+/*
+  Every component type has a distinct tag. The cache stores components
+  type-erased together with their tag, so that cache hits can restore the
+  type with a static cast instead of a dynamic_pointer_cast.
+*/
+template<typename ComponentType>
+inline constexpr char component_type_tag = 0;
+
+/*
+  Bound components by task-independent component and task. Binding the same
+  component to the same task twice yields the same bound component.
+
+  The cache can be shared by several threads. Each component is constructed
+  exactly once: the first thread that asks for a key constructs it, and
+  other threads asking for the same key wait until it is ready. If the
+  construction throws, all of them see the exception.
+
+  With a thread pool, independent arguments of a component are bound in
+  parallel (see bind_task_recursively).
+*/
+class Cache {
+    struct Entry {
+        // Set as soon as the component is constructed.
+        std::shared_ptr<void> component;
+        // Used for waiting while the component is under construction.
+        std::shared_future<std::shared_ptr<void>> pending_component;
+        const void *type_tag = nullptr;
+    };
+
+    utils::HashMap<CacheKey, Entry> entries;
+    // Only protects entries; components are constructed without the lock.
+    std::mutex mutex;
+    utils::ThreadPool *thread_pool;
+    Cache *task_independent_cache;
+    ComponentInterner *interner;
+    std::shared_ptr<utils::Arena> arena;
+public:
+    /*
+      Task-independent components are stored in task_independent_cache if
+      it is given. Using one such cache for the caches of many tasks shares
+      these components between the tasks, while everything else is
+      released with the cache of each task.
+    */
+    explicit Cache(
+        utils::ThreadPool *thread_pool = nullptr,
+        Cache *task_independent_cache = nullptr)
+        : thread_pool(thread_pool),
+          task_independent_cache(task_independent_cache),
+          interner(nullptr) {
+    }
+
+    Cache(const Cache &) = delete;
+    Cache &operator=(const Cache &) = delete;
+
+    /*
+      Return the component stored for key. If there is none, construct it
+      with create(), which may use the cache recursively for other keys.
+      All components stored for a key must have the same ComponentType.
+    */
+    template<typename ComponentType, typename Create>
+    std::shared_ptr<ComponentType> get_or_create(
+        const CacheKey &key, const Create &create) {
+        const void *type_tag = &component_type_tag<ComponentType>;
+        std::promise<std::shared_ptr<void>> promise;
+        std::shared_future<std::shared_ptr<void>> pending_component;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto [it, inserted] = entries.try_emplace(key);
+            Entry &entry = it->second;
+            if (inserted) {
+                entry.pending_component = promise.get_future().share();
+                entry.type_tag = type_tag;
+            } else {
+                assert(entry.type_tag == type_tag);
+                if (entry.component) {
+                    return std::static_pointer_cast<ComponentType>(
+                        entry.component);
+                }
+                pending_component = entry.pending_component;
+            }
+        }
+        if (pending_component.valid()) {
+            // Wait for the thread that constructs the component.
+            return std::static_pointer_cast<ComponentType>(
+                pending_component.get());
+        }
+        std::shared_ptr<ComponentType> component;
+        try {
+            component = create();
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+        promise.set_value(component);
+        {
+            // Entries move when the table grows, so we look it up again.
+            std::lock_guard<std::mutex> lock(mutex);
+            Entry &entry = entries.at(key);
+            entry.component = component;
+            entry.pending_component = {};
+        }
+        return component;
+    }
+
+    /*
+      Identify structurally equal components when binding with this cache
+      (see ComponentInterner). Caches that share a task-independent cache
+      should use the same interner.
+    */
+    void set_interner(ComponentInterner *component_interner) {
+        interner = component_interner;
+    }
+
+    ComponentInterner *get_interner() const {
+        return interner;
+    }
+
+    /*
+      Allocate the components stored in this cache in the given arena, so
+      that a bound component graph is stored contiguously and released in
+      one operation when its last component is destroyed. Only the
+      components themselves are placed in the arena, not the memory they
+      allocate internally. Task-independent components that go to a
+      separate task-independent cache use the arena of that cache, if any.
+    */
+    void set_arena(const std::shared_ptr<utils::Arena> &component_arena) {
+        arena = component_arena;
+    }
+
+    const std::shared_ptr<utils::Arena> &get_arena() const {
+        return arena;
+    }
+
+    /*
+      Return the cache for task-independent components. Components in it
+      may be used by several searches at once, so per-search state such as
+      value caches must not be enabled on them.
+    */
+    Cache &get_task_independent_cache() {
+        return task_independent_cache ? *task_independent_cache : *this;
+    }
+
+    /*
+      Call body(i) for all i in [0, num_iterations), on the thread pool if
+      there is one.
+    */
+    template<typename Body>
+    void parallel_for(std::size_t num_iterations, const Body &body) {
+        if (thread_pool) {
+            bind_profiler::Node *parent = bind_profiler::get_current_node();
+            thread_pool->parallel_for(num_iterations, [&](std::size_t i) {
+                bind_profiler::ParentScope profile_scope(parent);
+                body(i);
+            });
+        } else {
+            for (std::size_t i = 0; i < num_iterations; ++i) {
+                body(i);
+            }
+        }
+    }
+};
 
 template<typename Tuple>
 struct BoundArgs {
@@ -50,32 +225,64 @@ auto bind_task_recursively(
     return component->bind_task(task, cache);
 }
 
+template<typename T>
+using BoundType = decltype(bind_task_recursively(
+    std::declval<const T &>(),
+    std::declval<const std::shared_ptr<AbstractTask> &>(),
+    std::declval<Cache &>()));
+
+/*
+  The elements of vectors and tuples are independent of each other, so we
+  bind them in parallel if the cache has a thread pool. Components shared by
+  several elements are still constructed only once (see Cache).
+*/
 template<typename T>
 auto bind_task_recursively(
     const std::vector<T> &vec, const std::shared_ptr<AbstractTask> &task,
     Cache &cache) {
-    using BoundElementType = decltype(bind_task_recursively(
-        std::declval<T>(),
-        std::declval<const std::shared_ptr<AbstractTask> &>(),
-        std::declval<Cache &>()));
-    std::vector<BoundElementType> result;
-    result.reserve(vec.size());
-    for (const auto &elem : vec) {
-        result.push_back(bind_task_recursively(elem, task, cache));
+    if constexpr (std::is_default_constructible_v<BoundType<T>>) {
+        // Bind directly into the result, e.g. for components.
+        std::vector<BoundType<T>> result(vec.size());
+        cache.parallel_for(vec.size(), [&](std::size_t i) {
+            result[i] = bind_task_recursively(vec[i], task, cache);
+        });
+        return result;
+    } else {
+        std::vector<std::optional<BoundType<T>>> bound_elements(vec.size());
+        cache.parallel_for(vec.size(), [&](std::size_t i) {
+            bound_elements[i].emplace(
+                bind_task_recursively(vec[i], task, cache));
+        });
+        std::vector<BoundType<T>> result;
+        result.reserve(vec.size());
+        for (std::optional<BoundType<T>> &elem : bound_elements) {
+            result.push_back(std::move(*elem));
+        }
+        return result;
     }
-    return result;
+}
+
+template<typename... Args, std::size_t... Is>
+auto bind_tuple_elements(
+    const std::tuple<Args...> &args, const std::shared_ptr<AbstractTask> &task,
+    Cache &cache, std::index_sequence<Is...>) {
+    std::tuple<std::optional<BoundType<Args>>...> bound_elements;
+    cache.parallel_for(sizeof...(Args), [&](std::size_t i) {
+        ((i == Is ? (void)std::get<Is>(bound_elements)
+                        .emplace(bind_task_recursively(
+                            std::get<Is>(args), task, cache))
+                  : void()),
+         ...);
+    });
+    return std::make_tuple(std::move(*std::get<Is>(bound_elements))...);
 }
 
 template<typename... Args>
 auto bind_task_recursively(
     const std::tuple<Args...> &args, const std::shared_ptr<AbstractTask> &task,
     Cache &cache) {
-    return std::apply(
-        [&](const Args &...elems) {
-            return std::make_tuple(
-                bind_task_recursively(elems, task, cache)...);
-        },
-        args);
+    return bind_tuple_elements(
+        args, task, cache, std::index_sequence_for<Args...>());
 }
 
 template<typename T>
@@ -83,4 +290,48 @@ auto bind_task_recursively(
     const T &t, const std::shared_ptr<AbstractTask> &, Cache &) {
     return t;
 }
+
+/*
+  Return true if all components among the arguments are task-independent.
+  The overloads are declared before their definitions because they call
+  each other for nested non-class types, which are not found by ADL.
+*/
+template<typename T>
+bool are_task_independent_recursively(const T &);
+template<Bindable T>
+bool are_task_independent_recursively(const std::shared_ptr<T> &component);
+template<typename T>
+bool are_task_independent_recursively(const std::vector<T> &vec);
+template<typename... Args>
+bool are_task_independent_recursively(const std::tuple<Args...> &args);
+
+template<typename T>
+bool are_task_independent_recursively(const T &) {
+    return true;
+}
+
+template<Bindable T>
+bool are_task_independent_recursively(const std::shared_ptr<T> &component) {
+    return component->is_task_independent();
+}
+
+template<typename T>
+bool are_task_independent_recursively(const std::vector<T> &vec) {
+    for (const T &elem : vec) {
+        if (!are_task_independent_recursively(elem)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename... Args>
+bool are_task_independent_recursively(const std::tuple<Args...> &args) {
+    return std::apply(
+        [](const Args &...elems) {
+            return (are_task_independent_recursively(elems) && ...);
+        },
+        args);
+}
+
 #endif
@@ -2,20 +2,206 @@
 #define EVALUATOR_H
 
 #include "component.h"
+#include "state_id.h"
 
+#include "utils/hash.h"
 #include "utils/logging.h"
-#include <iostream>
+#include <cassert>
+#include <limits>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
 
 // fd
 //
 //
 class Evaluator : public TaskSpecificComponent {
+    const std::string description;
+
+    /*
+      Optional cache of computed values, keyed by state. Evaluators that
+      occur several times in an evaluator DAG are bound to one object by the
+      bind Cache, so with the cache enabled their values are computed at most
+      once per state. The search evicts states when it closes them, which
+      bounds the cache by the number of open states.
+    */
+    bool use_value_cache;
+    utils::HashMap<StateID, int> value_cache;
+    long long cache_hits;
+    long long cache_misses;
+    // Reused buffers for batch evaluation with the cache.
+    std::vector<StateID> uncached_state_ids;
+    std::vector<std::size_t> uncached_positions;
+    std::vector<int> uncached_values;
+
+    void evaluate_with_cache(
+        std::span<const StateID> state_ids, std::span<int> values);
+protected:
+    /*
+      Compute the value of the given state. Evaluators that detect a dead end
+      return INFTY.
+    */
+    mutable utils::LogProxy log;
+
+    virtual int compute_value(StateID state_id) = 0;
+
+    /*
+      Compute the values of a batch of states, e.g. all successors generated
+      by one expansion. Evaluators that combine other evaluators should
+      override this to evaluate each child once for the whole batch instead
+      of once per state. The default implementation evaluates the states one
+      by one.
+    */
+    virtual void compute_values(
+        std::span<const StateID> state_ids, std::span<int> values) {
+        for (std::size_t i = 0; i < state_ids.size(); ++i) {
+            values[i] = compute_value(state_ids[i]);
+        }
+    }
 public:
-    Evaluator(const std::shared_ptr<AbstractTask> &task)
-    : TaskSpecificComponent(task) {
+    static constexpr int INFTY = std::numeric_limits<int>::max();
+
+    Evaluator(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::string &description, utils::Verbosity verbosity)
+    : TaskSpecificComponent(task),
+      description(description),
+      use_value_cache(false),
+      cache_hits(0),
+      cache_misses(0),
+      log(verbosity) {
+    }
+
+    int evaluate(StateID state_id) {
+        if (!use_value_cache) {
+            return compute_value(state_id);
+        }
+        auto it = value_cache.find(state_id);
+        if (it != value_cache.end()) {
+            ++cache_hits;
+            return it->second;
+        }
+        ++cache_misses;
+        int value = compute_value(state_id);
+        value_cache.emplace(state_id, value);
+        return value;
+    }
+
+    void evaluate(std::span<const StateID> state_ids, std::span<int> values) {
+        assert(state_ids.size() == values.size());
+        if (use_value_cache) {
+            evaluate_with_cache(state_ids, values);
+        } else {
+            compute_values(state_ids, values);
+        }
+    }
+
+    /*
+      Evaluators whose value is a linear combination
+        constant + sum_i weight_i * child_i
+      of other evaluators, with the saturating semantics of
+      saturating_arithmetic, describe it here and return true. This allows
+      folding nested combinations into one evaluator at bind time. All other
+      evaluators return false.
+    */
+    virtual bool get_linear_terms(
+        int &, std::vector<std::pair<int, std::shared_ptr<Evaluator>>> &) const {
+        return false;
+    }
+
+    /*
+      Add this evaluator and all evaluators it uses to evals.
+    */
+    virtual void get_involved_evaluators(std::set<Evaluator *> &evals) {
+        evals.insert(this);
+    }
+
+    utils::Verbosity get_verbosity() const {
+        return log.get_verbosity();
+    }
+
+    const std::string &get_description() const {
+        return description;
+    }
+
+    /*
+      The value cache is opt-in because it only pays off for evaluators that
+      are expensive or shared by several parts of a configuration.
+    */
+    void enable_value_cache() {
+        use_value_cache = true;
+    }
+
+    bool uses_value_cache() const {
+        return use_value_cache;
+    }
+
+    void evict_cached_value(StateID state_id) {
+        if (use_value_cache) {
+            value_cache.erase(state_id);
+        }
+    }
+
+    /*
+      Drop all cached values and reset the counters, e.g. when a new search
+      with a new state registry starts.
+    */
+    void clear_value_cache() {
+        value_cache.clear();
+        cache_hits = 0;
+        cache_misses = 0;
+    }
+
+    long long get_cache_hits() const {
+        return cache_hits;
+    }
+
+    long long get_cache_misses() const {
+        return cache_misses;
     }
 
     virtual void dump() = 0;
 };
 
+/*
+  Fold constant subexpressions of freshly bound evaluators and merge nested
+  sums and weighted evaluators into a single linear combination over
+  distinct leaf evaluators. This runs on every bound evaluator as soon as it
+  is created, so the children of a combining evaluator have been folded
+  already. See evaluators/linear_combination_evaluator.cc.
+*/
+template<>
+struct BoundComponentOptimizer<Evaluator> {
+    static std::shared_ptr<Evaluator> optimize(
+        std::shared_ptr<Evaluator> evaluator,
+        const std::shared_ptr<AbstractTask> &task);
+};
+
+inline void Evaluator::evaluate_with_cache(
+    std::span<const StateID> state_ids, std::span<int> values) {
+    uncached_state_ids.clear();
+    uncached_positions.clear();
+    for (std::size_t i = 0; i < state_ids.size(); ++i) {
+        auto it = value_cache.find(state_ids[i]);
+        if (it != value_cache.end()) {
+            ++cache_hits;
+            values[i] = it->second;
+        } else {
+            uncached_state_ids.push_back(state_ids[i]);
+            uncached_positions.push_back(i);
+        }
+    }
+    if (uncached_state_ids.empty()) {
+        return;
+    }
+    cache_misses += uncached_state_ids.size();
+    uncached_values.resize(uncached_state_ids.size());
+    compute_values(uncached_state_ids, uncached_values);
+    for (std::size_t j = 0; j < uncached_state_ids.size(); ++j) {
+        values[uncached_positions[j]] = uncached_values[j];
+        value_cache.emplace(uncached_state_ids[j], uncached_values[j]);
+    }
+}
+
 #endif
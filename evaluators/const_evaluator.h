@@ -2,16 +2,40 @@
 #define EVALUATORS_CONST_EVALUATOR_H
 #include "../evaluator.h"
 
+#include <algorithm>
+
 namespace const_evaluator {
-class ConstEvaluator : public Evaluator {
+class ConstEvaluator final : public Evaluator {
     int c;
+protected:
+    int compute_value(StateID) override {
+        return c;
+    }
+
+    void compute_values(
+        std::span<const StateID>, std::span<int> values) override {
+        std::fill(values.begin(), values.end(), c);
+    }
 public:
+    static constexpr bool task_independent = true;
+
     ConstEvaluator(
         const std::shared_ptr<AbstractTask> &, int c,
         const std::string &description, utils::Verbosity);
 
+    int get_value() const {
+        return c;
+    }
+
+    bool get_linear_terms(
+        int &constant,
+        std::vector<std::pair<int, std::shared_ptr<Evaluator>>> &) const override {
+        constant = c;
+        return true;
+    }
+
     void dump() override {
-        std::cout << c << std::endl;
+        log << c << '\n';
     }
 };
 }
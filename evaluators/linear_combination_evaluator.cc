@@ -0,0 +1,183 @@
+#include "linear_combination_evaluator.h"
+
+#include "const_evaluator.h"
+#include "saturating_arithmetic.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+using namespace std;
+
+LinearCombinationEvaluator::LinearCombinationEvaluator(
+    const shared_ptr<AbstractTask> &task, int constant,
+    const vector<int> &weights, const vector<shared_ptr<Evaluator>> &evals,
+    const string &description, utils::Verbosity verbosity)
+    : Evaluator(task, description, verbosity),
+      constant(constant),
+      weights(weights),
+      evals(evals) {
+    assert(weights.size() == evals.size());
+}
+
+int LinearCombinationEvaluator::compute_value(StateID state_id) {
+    int result = constant;
+    for (size_t i = 0; i < evals.size() && result != INFTY; ++i) {
+        int value = evals[i]->evaluate(state_id);
+        saturating_arithmetic::scale(span<int>(&value, 1), weights[i]);
+        saturating_arithmetic::add(span<int>(&result, 1), span<int>(&value, 1));
+    }
+    return result;
+}
+
+void LinearCombinationEvaluator::compute_values(
+    span<const StateID> state_ids, span<int> values) {
+    fill(values.begin(), values.end(), constant);
+    if (constant == INFTY) {
+        return;
+    }
+    // See SumEvaluator::compute_values.
+    const size_t chunk_size = 256;
+    array<int, chunk_size> buffer;
+    for (size_t start = 0; start < state_ids.size(); start += chunk_size) {
+        size_t length = min(chunk_size, state_ids.size() - start);
+        span<const StateID> chunk_ids = state_ids.subspan(start, length);
+        span<int> chunk_values = values.subspan(start, length);
+        span<int> summands(buffer.data(), length);
+        for (size_t i = 0; i < evals.size(); ++i) {
+            evals[i]->evaluate(chunk_ids, summands);
+            saturating_arithmetic::scale(summands, weights[i]);
+            saturating_arithmetic::add(chunk_values, summands);
+        }
+    }
+}
+
+bool LinearCombinationEvaluator::get_linear_terms(
+    int &constant, vector<pair<int, shared_ptr<Evaluator>>> &terms) const {
+    constant = this->constant;
+    for (size_t i = 0; i < evals.size(); ++i) {
+        terms.emplace_back(weights[i], evals[i]);
+    }
+    return true;
+}
+
+void LinearCombinationEvaluator::get_involved_evaluators(
+    set<Evaluator *> &evals) {
+    evals.insert(this);
+    for (const shared_ptr<Evaluator> &eval : this->evals) {
+        eval->get_involved_evaluators(evals);
+    }
+}
+
+void LinearCombinationEvaluator::dump() {
+    log << constant;
+    for (size_t i = 0; i < evals.size(); ++i) {
+        log << " + " << weights[i] << " * ";
+        evals[i]->dump();
+    }
+    log << '\n';
+}
+
+
+namespace {
+/*
+  Weights of merged terms multiply and add up. We saturate them at INFTY,
+  which saturating_arithmetic::scale accepts as a weight: it maps 0 to 0
+  and every positive value to INFTY, exactly like a larger weight would.
+
+  Multiplying weights preserves the saturating semantics as long as the
+  outer weight is positive: w1 * (w2 * e) saturates iff w2 * e does or
+  w1 * w2 * e does, which for w1 >= 1 is iff (w1 * w2) * e does. Outer
+  weights of 0 are handled in LinearCombinationBuilder::add.
+*/
+int multiply_weights(int lhs, int rhs) {
+    int64_t product = static_cast<int64_t>(lhs) * rhs;
+    return static_cast<int>(min<int64_t>(product, Evaluator::INFTY));
+}
+
+int add_weights(int lhs, int rhs) {
+    int64_t sum = static_cast<int64_t>(lhs) + rhs;
+    return static_cast<int>(min<int64_t>(sum, Evaluator::INFTY));
+}
+
+class LinearCombinationBuilder {
+    int constant = 0;
+    vector<int> weights;
+    vector<shared_ptr<Evaluator>> leaves;
+    utils::HashMap<const Evaluator *, size_t> leaf_indices;
+public:
+    /*
+      Add weight * evaluator, expanding evaluators that are linear
+      combinations themselves.
+    */
+    void add(int weight, const shared_ptr<Evaluator> &evaluator) {
+        int evaluator_constant = 0;
+        vector<pair<int, shared_ptr<Evaluator>>> terms;
+        bool is_linear =
+            evaluator->get_linear_terms(evaluator_constant, terms);
+        /*
+          Weight 0 maps INFTY to INFTY and everything else to 0, so 0 * e is
+          INFTY iff e is. If e is a combination with terms, e can saturate
+          although none of its terms is INFTY (e.g. e = 2 * e' with a large
+          value of e'), but the expanded terms 0 * e' would not. We
+          therefore keep such combinations as leaves.
+        */
+        if (!is_linear || (weight == 0 && !terms.empty())) {
+            auto [it, inserted] =
+                leaf_indices.emplace(evaluator.get(), leaves.size());
+            if (inserted) {
+                weights.push_back(weight);
+                leaves.push_back(evaluator);
+            } else {
+                /*
+                  Merging w1 * e + w2 * e into (w1 + w2) * e preserves the
+                  saturating semantics: both saturate iff e is infinite or
+                  (w1 + w2) * e reaches INFTY.
+                */
+                weights[it->second] = add_weights(weights[it->second], weight);
+            }
+            return;
+        }
+        saturating_arithmetic::scale(
+            span<int>(&evaluator_constant, 1), weight);
+        saturating_arithmetic::add(
+            span<int>(&constant, 1), span<int>(&evaluator_constant, 1));
+        for (const auto &[term_weight, term] : terms) {
+            add(multiply_weights(weight, term_weight), term);
+        }
+    }
+
+    shared_ptr<Evaluator> build(
+        const shared_ptr<AbstractTask> &task, const string &description,
+        utils::Verbosity verbosity) {
+        if (leaves.empty() || constant == Evaluator::INFTY) {
+            return make_shared<const_evaluator::ConstEvaluator>(
+                task, constant, description, verbosity);
+        }
+        if (constant == 0 && leaves.size() == 1 && weights[0] == 1) {
+            return leaves[0];
+        }
+        return make_shared<LinearCombinationEvaluator>(
+            task, constant, weights, leaves, description, verbosity);
+    }
+};
+}
+
+shared_ptr<Evaluator> BoundComponentOptimizer<Evaluator>::optimize(
+    shared_ptr<Evaluator> evaluator, const shared_ptr<AbstractTask> &task) {
+    int constant = 0;
+    vector<pair<int, shared_ptr<Evaluator>>> terms;
+    /*
+      Leaves and constants are left alone. Everything else was just created
+      from children that have been folded already, so we only need to look
+      one level deep to flatten the whole expression.
+    */
+    if (!evaluator->get_linear_terms(constant, terms) || terms.empty()) {
+        return evaluator;
+    }
+    LinearCombinationBuilder builder;
+    builder.add(1, evaluator);
+    return builder.build(
+        task, evaluator->get_description(), evaluator->get_verbosity());
+}
@@ -0,0 +1,43 @@
+#ifndef EVALUATORS_LINEAR_COMBINATION_EVALUATOR_H
+#define EVALUATORS_LINEAR_COMBINATION_EVALUATOR_H
+
+#include "../evaluator.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+  Evaluator computing constant + sum_i weights[i] * evals[i] with the
+  saturating semantics of saturating_arithmetic (INFTY is absorbing).
+
+  This evaluator is not meant to be configured directly. It is the result of
+  folding trees of sum, weighted and constant evaluators at bind time (see
+  BoundComponentOptimizer<Evaluator>), which replaces a chain of virtual
+  calls per state by one loop over the distinct leaf evaluators.
+*/
+class LinearCombinationEvaluator final : public Evaluator {
+    int constant;
+    std::vector<int> weights;
+    std::vector<std::shared_ptr<Evaluator>> evals;
+protected:
+    int compute_value(StateID state_id) override;
+    void compute_values(
+        std::span<const StateID> state_ids, std::span<int> values) override;
+public:
+    LinearCombinationEvaluator(
+        const std::shared_ptr<AbstractTask> &task, int constant,
+        const std::vector<int> &weights,
+        const std::vector<std::shared_ptr<Evaluator>> &evals,
+        const std::string &description, utils::Verbosity verbosity);
+
+    bool get_linear_terms(
+        int &constant,
+        std::vector<std::pair<int, std::shared_ptr<Evaluator>>> &terms)
+        const override;
+    void get_involved_evaluators(std::set<Evaluator *> &evals) override;
+
+    void dump() override;
+};
+
+#endif
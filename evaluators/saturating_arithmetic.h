@@ -0,0 +1,96 @@
+#ifndef EVALUATORS_SATURATING_ARITHMETIC_H
+#define EVALUATORS_SATURATING_ARITHMETIC_H
+
+#include "../evaluator.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+/*
+  Kernels for combining arrays of evaluator values, as used by the batch
+  evaluation of combining evaluators. Values are non-negative, and
+  Evaluator::INFTY is absorbing: any combination involving INFTY is INFTY.
+  Results that would exceed the largest finite value also become INFTY.
+
+  The kernels are branch-free, so they process several values per
+  instruction. With GCC and Clang, we use their portable vector extensions,
+  which compile to the SIMD instructions of the target (SSE2 on plain
+  x86-64) even without optimization flags. Other compilers get scalar loops
+  with the same semantics.
+*/
+namespace saturating_arithmetic {
+#if defined(__GNUC__)
+#define SATURATING_ARITHMETIC_USE_VECTOR_EXTENSIONS
+static const std::size_t LANES = 8;
+typedef std::uint32_t Lanes __attribute__((vector_size(LANES * 4)));
+
+static_assert(sizeof(int) == 4);
+#endif
+
+/*
+  Set values[i] to values[i] + summands[i] for all i.
+*/
+inline void add(std::span<int> values, std::span<const int> summands) {
+    assert(values.size() == summands.size());
+    const std::uint32_t infty = Evaluator::INFTY;
+    std::size_t i = 0;
+#ifdef SATURATING_ARITHMETIC_USE_VECTOR_EXTENSIONS
+    for (; i + LANES <= values.size(); i += LANES) {
+        Lanes lhs, rhs;
+        std::memcpy(&lhs, values.data() + i, sizeof(Lanes));
+        std::memcpy(&rhs, summands.data() + i, sizeof(Lanes));
+        /*
+          Both inputs are at most INFTY = 2^31 - 1, so the unsigned sum does
+          not wrap around, and it is at least INFTY iff the result saturates.
+        */
+        Lanes sum = lhs + rhs;
+        Lanes saturated = sum >= infty;
+        sum = (sum & ~saturated) | (infty & saturated);
+        std::memcpy(values.data() + i, &sum, sizeof(Lanes));
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        assert(values[i] >= 0 && summands[i] >= 0);
+        std::uint32_t sum = static_cast<std::uint32_t>(values[i]) +
+                            static_cast<std::uint32_t>(summands[i]);
+        values[i] = sum >= infty ? Evaluator::INFTY : static_cast<int>(sum);
+    }
+}
+
+/*
+  Set values[i] to weight * values[i] for all i. The weight must be
+  non-negative.
+*/
+inline void scale(std::span<int> values, int weight) {
+    assert(weight >= 0);
+    const std::uint32_t infty = Evaluator::INFTY;
+    // Values above limit would reach or exceed INFTY when multiplied.
+    const std::uint32_t limit = weight == 0 ? infty - 1 : (infty - 1) / weight;
+    const std::uint32_t factor = weight;
+    std::size_t i = 0;
+#ifdef SATURATING_ARITHMETIC_USE_VECTOR_EXTENSIONS
+    for (; i + LANES <= values.size(); i += LANES) {
+        Lanes lanes;
+        std::memcpy(&lanes, values.data() + i, sizeof(Lanes));
+        Lanes saturated = lanes > limit;
+        // Lanes that saturate may wrap around here, but they are masked out.
+        Lanes product = lanes * factor;
+        product = (product & ~saturated) | (infty & saturated);
+        std::memcpy(values.data() + i, &product, sizeof(Lanes));
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        assert(values[i] >= 0);
+        std::uint32_t value = values[i];
+        values[i] = value > limit ? Evaluator::INFTY
+                                  : static_cast<int>(value * factor);
+    }
+}
+
+#undef SATURATING_ARITHMETIC_USE_VECTOR_EXTENSIONS
+}
+
+#endif
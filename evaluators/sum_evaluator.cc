@@ -1,11 +1,55 @@
 #include "sum_evaluator.h"
 
+#include "saturating_arithmetic.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
 using namespace std;
 
 SumEvaluator::SumEvaluator(
     const std::shared_ptr<AbstractTask> &task,
     const std::vector<std::shared_ptr<Evaluator>> &evals,
-    const std::string &description, utils::Verbosity verboisity)
-    : Evaluator(task), evals(evals) {
-    std::cout << "SumEvalConstructor.cc" << std::endl;
+    const std::string &description, utils::Verbosity verbosity)
+    : Evaluator(task, description, verbosity), evals(evals) {
+    log << "SumEvalConstructor.cc" << '\n';
+}
+
+int SumEvaluator::compute_value(StateID state_id) {
+    int result = 0;
+    for (const shared_ptr<Evaluator> &eval : evals) {
+        int value = eval->evaluate(state_id);
+        saturating_arithmetic::add(span<int>(&result, 1), span<int>(&value, 1));
+        if (result == INFTY) {
+            return INFTY;
+        }
+    }
+    return result;
+}
+
+void SumEvaluator::compute_values(
+    span<const StateID> state_ids, span<int> values) {
+    if (evals.empty()) {
+        fill(values.begin(), values.end(), 0);
+        return;
+    }
+    evals[0]->evaluate(state_ids, values);
+    /*
+      Evaluate the other children in chunks into a buffer on the stack. This
+      avoids allocating, keeps the buffer in the L1 cache and makes the
+      evaluator safe to use from several threads.
+    */
+    const size_t chunk_size = 256;
+    array<int, chunk_size> buffer;
+    for (size_t start = 0; start < state_ids.size(); start += chunk_size) {
+        size_t length = min(chunk_size, state_ids.size() - start);
+        span<const StateID> chunk_ids = state_ids.subspan(start, length);
+        span<int> chunk_values = values.subspan(start, length);
+        span<int> summands(buffer.data(), length);
+        for (size_t i = 1; i < evals.size(); ++i) {
+            evals[i]->evaluate(chunk_ids, summands);
+            saturating_arithmetic::add(chunk_values, summands);
+        }
+    }
 }
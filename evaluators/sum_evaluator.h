@@ -3,19 +3,43 @@
 
 #include "../evaluator.h"
 
-class SumEvaluator : public Evaluator {
+class SumEvaluator final : public Evaluator {
     std::vector<std::shared_ptr<Evaluator>> evals;
+protected:
+    int compute_value(StateID state_id) override;
+    void compute_values(
+        std::span<const StateID> state_ids, std::span<int> values) override;
 public:
+    static constexpr bool task_independent = true;
+
     SumEvaluator(
         const std::shared_ptr<AbstractTask> &,
         const std::vector<std::shared_ptr<Evaluator>> &evals,
-        const std::string &description, utils::Verbosity verboisity);
+        const std::string &description, utils::Verbosity verbosity);
+
+    bool get_linear_terms(
+        int &constant,
+        std::vector<std::pair<int, std::shared_ptr<Evaluator>>> &terms)
+        const override {
+        constant = 0;
+        for (const std::shared_ptr<Evaluator> &eval : evals) {
+            terms.emplace_back(1, eval);
+        }
+        return true;
+    }
+
+    void get_involved_evaluators(std::set<Evaluator *> &evals) override {
+        evals.insert(this);
+        for (const std::shared_ptr<Evaluator> &eval : this->evals) {
+            eval->get_involved_evaluators(evals);
+        }
+    }
 
     void dump() override {
         for (auto eval : evals) {
-            std::cout << " +++ ";
+            log << " +++ ";
             eval->dump();
-            std::cout << std::endl;
+            log << '\n';
         }
     }
 };
@@ -3,20 +3,51 @@
 
 #include "../evaluator.h"
 
-class WeightedEvaluator : public Evaluator {
+#include "saturating_arithmetic.h"
+
+class WeightedEvaluator final : public Evaluator {
     int w;
     std::shared_ptr<Evaluator> eval;
+protected:
+    int compute_value(StateID state_id) override {
+        int value = eval->evaluate(state_id);
+        saturating_arithmetic::scale(std::span<int>(&value, 1), w);
+        return value;
+    }
+
+    void compute_values(
+        std::span<const StateID> state_ids, std::span<int> values) override {
+        eval->evaluate(state_ids, values);
+        saturating_arithmetic::scale(values, w);
+    }
 public:
+    static constexpr bool task_independent = true;
+
     WeightedEvaluator(
         const std::shared_ptr<AbstractTask> &task, int w,
-        const std::shared_ptr<Evaluator> &eval, std::string, utils::Verbosity)
-        : Evaluator(task), w(w), eval(eval) {
-        std::cout << "WeightedEvalConstructor" << std::endl;
+        const std::shared_ptr<Evaluator> &eval, const std::string &description,
+        utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), w(w), eval(eval) {
+        log << "WeightedEvalConstructor" << '\n';
     }
+    bool get_linear_terms(
+        int &constant,
+        std::vector<std::pair<int, std::shared_ptr<Evaluator>>> &terms)
+        const override {
+        constant = 0;
+        terms.emplace_back(w, eval);
+        return true;
+    }
+
+    void get_involved_evaluators(std::set<Evaluator *> &evals) override {
+        evals.insert(this);
+        eval->get_involved_evaluators(evals);
+    }
+
     void dump() override {
-        std::cout << w << " * ";
+        log << w << " * ";
         eval->dump();
-        std::cout << std::endl;
+        log << '\n';
     }
 };
 
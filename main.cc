@@ -1,18 +1,50 @@
 #include "component.h"
 #include "open_list_factory.h"
+#include "portfolio_runner.h"
 
 #include "evaluators/const_evaluator.h"
 #include "evaluators/sum_evaluator.h"
 #include "evaluators/weighted_evaluator.h"
+#include "open_lists/radix_heap_open_list.h"
 #include "open_lists/tiebreaking_open_list.h"
 #include "search_algorithms/eager.h"
+#include "tasks/explicit_task.h"
+#include "utils/arena.h"
+#include "utils/logging.h"
+#include "utils/thread_pool.h"
 
-#include <iostream>
+#include <fstream>
 #include <memory>
 #include <vector>
 
 using namespace std;
 
+/*
+  Example task: num_counters counters with values 0, ..., max_value that can
+  be incremented and decremented one step at a time. All counters start at 0
+  and have to reach max_value.
+*/
+static shared_ptr<AbstractTask> create_counters_task(
+    int num_counters, int max_value) {
+    vector<tasks::ExplicitOperator> operators;
+    for (int var = 0; var < num_counters; ++var) {
+        for (int value = 0; value < max_value; ++value) {
+            string suffix = to_string(var) + "-" + to_string(value);
+            operators.push_back(
+                {"inc-" + suffix, 1, {{var, value}}, {{var, value + 1}}});
+            operators.push_back(
+                {"dec-" + suffix, 1, {{var, value + 1}}, {{var, value}}});
+        }
+    }
+    vector<FactPair> goals;
+    for (int var = 0; var < num_counters; ++var) {
+        goals.emplace_back(var, max_value);
+    }
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>(num_counters, max_value + 1), operators, goals,
+        vector<int>(num_counters, 0));
+}
+
 int main() {
     using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
     using OpenListComponent =
@@ -31,14 +63,14 @@ int main() {
         make_shared_component<SumEvaluator, Evaluator>(
             tuple(evals, "sum_eval", utils::Verbosity::NORMAL));
 
-    shared_ptr<AbstractTask> task;
+    shared_ptr<AbstractTask> task = create_counters_task(3, 7);
     shared_ptr<Evaluator> bound_w_eval = w_eval->bind_task(task);
     bound_w_eval->dump();
-    cout << "- - - - -- " << endl;
+    utils::g_log << "- - - - -- " << '\n';
     shared_ptr<Evaluator> bound_sum_eval = sum_eval->bind_task(task);
     bound_sum_eval->dump();
 
-    cout << "- - - " << endl;
+    utils::g_log << "- - - " << '\n';
 
     OpenListComponent tb_olist =
         make_shared_component<TieBreakingOpenListFactory, OpenListFactory>(
@@ -46,7 +78,87 @@ int main() {
     SearchComponent eager =
         make_shared_component<eager_search::EagerSearch, SearchAlgorithm>(
             tuple(tb_olist, sum_eval, "eager" /*1*/, utils::Verbosity::NORMAL));
-    shared_ptr<SearchAlgorithm> bound_eager = eager->bind_task(task);
+    /*
+      c_eval occurs several times in the evaluators of the search. Binding it
+      with the same Cache as the search gives us the shared bound evaluator,
+      on which we enable the value cache.
+    */
+    Cache cache;
+    shared_ptr<Evaluator> bound_c_eval = c_eval->bind_task(task, cache);
+    bound_c_eval->enable_value_cache();
+    shared_ptr<SearchAlgorithm> bound_eager = eager->bind_task(task, cache);
     bound_eager->dump();
-    cout << "done" << endl;
+    bound_eager->search();
+    bound_eager->print_statistics();
+    utils::g_log << "Plan length: " << bound_eager->get_plan().size() << '\n';
+
+    utils::g_log << "- - - " << '\n';
+
+    OpenListComponent radix_olist =
+        make_shared_component<RadixHeapOpenListFactory, OpenListFactory>(
+            tuple(sum_eval, false, "radix", utils::Verbosity::NORMAL));
+    SearchComponent radix_eager =
+        make_shared_component<eager_search::EagerSearch, SearchAlgorithm>(
+            tuple(radix_olist, sum_eval, "radix_eager", utils::Verbosity::NORMAL));
+    /*
+      Bind the independent arguments of components on several threads and
+      place the bound components next to each other in an arena.
+    */
+    utils::ThreadPool thread_pool(3);
+    Cache parallel_cache(&thread_pool);
+    parallel_cache.set_arena(make_shared<utils::Arena>());
+    shared_ptr<SearchAlgorithm> bound_radix_eager =
+        radix_eager->bind_task(task, parallel_cache);
+    bound_radix_eager->dump();
+
+    utils::g_log << "- - - " << '\n';
+
+    /*
+      With an interner, the cache binds structurally equal components to
+      the same object.
+    */
+    EvaluatorComponent c_eval_copy =
+        make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+            tuple(2, "c_eval", utils::Verbosity::NORMAL));
+    ComponentInterner interner;
+    Cache interning_cache;
+    interning_cache.set_interner(&interner);
+    bool shared_bound_eval = c_eval->bind_task(task, interning_cache) ==
+                             c_eval_copy->bind_task(task, interning_cache);
+    utils::g_log << "Structurally equal evaluators share a bound object: "
+                 << (shared_bound_eval ? "true" : "false") << '\n';
+
+    utils::g_log << "- - - " << '\n';
+
+    vector<shared_ptr<AbstractTask>> portfolio_tasks;
+    for (int num_counters = 1; num_counters <= 4; ++num_counters) {
+        for (int max_value = 2; max_value <= 8; max_value += 2) {
+            portfolio_tasks.push_back(
+                create_counters_task(num_counters, max_value));
+        }
+    }
+    portfolio_runner::PortfolioRunner portfolio(4, 64 * 1024);
+    portfolio_runner::PortfolioStatistics portfolio_statistics =
+        portfolio.run(
+            eager, portfolio_tasks,
+            [](const portfolio_runner::TaskResult &result) {
+                utils::g_log << "Task " << result.task_index << ": status "
+                             << result.status << ", plan length "
+                             << result.plan.size() << ", "
+                             << result.num_bytes << " bytes" << '\n';
+                if (result.status == ERROR) {
+                    utils::g_log << "Task " << result.task_index
+                                 << " failed: " << result.error << '\n';
+                }
+            });
+    portfolio_statistics.print(utils::g_log);
+
+#ifdef BIND_PROFILING
+    ofstream bind_profile_json("bind_profile.json");
+    bind_profiler::write_json(bind_profile_json);
+    ofstream bind_profile_folded("bind_profile.folded");
+    bind_profiler::write_folded_stacks(bind_profile_folded);
+#endif
+    utils::g_log << "done" << '\n';
+    utils::flush_log();
 }
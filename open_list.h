@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <set>
+#include <span>
 
 class StateID;
 class OperatorID;
@@ -15,10 +16,60 @@ template<class Entry>
 class OpenList {
     bool only_preferred;
 
+protected:
+    /*
+      Add an entry to the open list. Implementations compute the key of the
+      entry from their evaluators and may drop entries that are recognized as
+      dead ends.
+    */
+    virtual void do_insertion(const Entry &entry) = 0;
+
+    /*
+      Add a batch of entries. Implementations should evaluate each of their
+      evaluators once for the whole batch (see Evaluator::compute_values).
+      The default implementation inserts the entries one by one.
+    */
+    virtual void do_batch_insertion(std::span<const Entry> entries) {
+        for (const Entry &entry : entries) {
+            do_insertion(entry);
+        }
+    }
+
 public:
     explicit OpenList(bool preferred_only = false);
     virtual ~OpenList() = default;
 
+    /*
+      Insert an entry. If the open list only accepts preferred entries, other
+      entries are ignored.
+    */
+    void insert(const Entry &entry, bool preferred = false);
+
+    /*
+      Insert a batch of non-preferred entries, e.g. all successors of an
+      expansion.
+    */
+    void insert(std::span<const Entry> entries);
+
+    /*
+      Remove and return an entry with minimal key. Entries with equal keys
+      are returned in insertion order. The open list must not be empty.
+    */
+    virtual Entry remove_min() = 0;
+
+    virtual bool empty() const = 0;
+    virtual void clear() = 0;
+
+    /*
+      Add the evaluators that determine the keys of entries and all
+      evaluators they use to evals.
+    */
+    virtual void get_involved_evaluators(std::set<Evaluator *> &evals) = 0;
+
+    bool only_contains_preferred_entries() const {
+        return only_preferred;
+    }
+
     virtual void dump() = 0;
 };
 
@@ -28,9 +79,35 @@ using EdgeOpenListEntry = std::pair<StateID, OperatorID>;
 using StateOpenList = OpenList<StateOpenListEntry>;
 using EdgeOpenList = OpenList<EdgeOpenListEntry>;
 
+/*
+  Return the state whose evaluator values determine the key of an entry. For
+  edges, this is the state from which the edge starts.
+*/
+inline StateID get_state_id(const StateOpenListEntry &entry) {
+    return entry;
+}
+
+inline StateID get_state_id(const EdgeOpenListEntry &entry) {
+    return entry.first;
+}
+
 template<class Entry>
 OpenList<Entry>::OpenList(bool only_preferred)
     : only_preferred(only_preferred) {
 }
 
+template<class Entry>
+void OpenList<Entry>::insert(const Entry &entry, bool preferred) {
+    if (only_preferred && !preferred)
+        return;
+    do_insertion(entry);
+}
+
+template<class Entry>
+void OpenList<Entry>::insert(std::span<const Entry> entries) {
+    if (only_preferred || entries.empty())
+        return;
+    do_batch_insertion(entries);
+}
+
 #endif
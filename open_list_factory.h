@@ -8,9 +8,12 @@
 #include <memory>
 
 class OpenListFactory : public TaskSpecificComponent {
+protected:
+    mutable utils::LogProxy log;
 public:
-    OpenListFactory(const std::shared_ptr<AbstractTask> &task)
-    : TaskSpecificComponent(task) {
+    OpenListFactory(
+        const std::shared_ptr<AbstractTask> &task, utils::Verbosity verbosity)
+    : TaskSpecificComponent(task), log(verbosity) {
     }
 
     virtual ~OpenListFactory() = default;
@@ -0,0 +1,327 @@
+#include "radix_heap_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+/*
+  Radix heap for non-negative integer keys (Ahuja, Mehlhorn, Orlin and
+  Tarjan, 1990). It requires that no key smaller than the last removed key
+  is inserted. Bucket 0 holds the entries whose key equals the last removed
+  key, bucket i > 0 holds the entries whose key first differs from it in bit
+  i - 1. When bucket 0 runs empty, we take the lowest non-empty bucket and
+  redistribute its entries into lower buckets relative to its minimum key.
+  Each entry moves to a lower bucket at most once per bit, so all operations
+  are amortized O(number of bits).
+*/
+template<class Entry>
+class RadixHeap {
+    using Key = uint32_t;
+    static const int NUM_BUCKETS = numeric_limits<Key>::digits + 1;
+
+    array<vector<pair<Key, Entry>>, NUM_BUCKETS> buckets;
+    // Bucket 0 is consumed from the front to keep its entries in FIFO order.
+    size_t bucket_0_head = 0;
+    Key last_key = 0;
+    size_t num_entries = 0;
+
+    static int get_bucket(Key key, Key last) {
+        if (key == last) {
+            return 0;
+        }
+        return numeric_limits<Key>::digits - countl_zero(key ^ last);
+    }
+
+    void refill_bucket_0() {
+        int index = 1;
+        while (buckets[index].empty()) {
+            ++index;
+        }
+        vector<pair<Key, Entry>> bucket;
+        bucket.swap(buckets[index]);
+        Key new_last = bucket.front().first;
+        for (const auto &[key, entry] : bucket) {
+            new_last = min(new_last, key);
+        }
+        last_key = new_last;
+        for (auto &key_and_entry : bucket) {
+            int new_index = get_bucket(key_and_entry.first, last_key);
+            assert(new_index < index);
+            buckets[new_index].push_back(move(key_and_entry));
+        }
+        // Reuse the memory of the redistributed bucket.
+        bucket.clear();
+        buckets[index].swap(bucket);
+    }
+
+public:
+    Key get_last_key() const {
+        return last_key;
+    }
+
+    void push(Key key, const Entry &entry) {
+        assert(key >= last_key);
+        buckets[get_bucket(key, last_key)].emplace_back(key, entry);
+        ++num_entries;
+    }
+
+    pair<Key, Entry> pop() {
+        assert(!empty());
+        if (bucket_0_head == buckets[0].size()) {
+            buckets[0].clear();
+            bucket_0_head = 0;
+            refill_bucket_0();
+        }
+        --num_entries;
+        return move(buckets[0][bucket_0_head++]);
+    }
+
+    bool empty() const {
+        return num_entries == 0;
+    }
+
+    /*
+      Move all entries into result and leave the heap empty. The order of the
+      result is unspecified.
+    */
+    void extract_all(vector<pair<Key, Entry>> &result) {
+        for (size_t i = bucket_0_head; i < buckets[0].size(); ++i) {
+            result.push_back(move(buckets[0][i]));
+        }
+        for (int i = 1; i < NUM_BUCKETS; ++i) {
+            for (auto &key_and_entry : buckets[i]) {
+                result.push_back(move(key_and_entry));
+            }
+        }
+        clear();
+    }
+
+    void clear() {
+        for (auto &bucket : buckets) {
+            vector<pair<Key, Entry>>().swap(bucket);
+        }
+        bucket_0_head = 0;
+        last_key = 0;
+        num_entries = 0;
+    }
+};
+
+
+/*
+  Pairing heap (Fredman, Sedgewick, Sleator and Tarjan, 1986) without any
+  monotonicity requirement. Nodes are kept in a vector and linked by index,
+  with a free list for reusing the nodes of removed entries. Ties are broken
+  in FIFO order by an insertion counter.
+*/
+template<class Entry>
+class PairingHeap {
+    struct Node {
+        uint32_t key;
+        uint64_t insertion_id;
+        Entry entry;
+        int child;
+        int sibling;
+    };
+
+    static const int NONE = -1;
+
+    vector<Node> nodes;
+    vector<int> free_nodes;
+    int root = NONE;
+    size_t num_entries = 0;
+    uint64_t next_insertion_id = 0;
+    // Scratch space for the pairing passes of pop().
+    vector<int> pairs;
+
+    bool less(int lhs, int rhs) const {
+        const Node &a = nodes[lhs];
+        const Node &b = nodes[rhs];
+        return a.key < b.key ||
+               (a.key == b.key && a.insertion_id < b.insertion_id);
+    }
+
+    int meld(int lhs, int rhs) {
+        if (lhs == NONE)
+            return rhs;
+        if (rhs == NONE)
+            return lhs;
+        if (less(rhs, lhs))
+            swap(lhs, rhs);
+        nodes[rhs].sibling = nodes[lhs].child;
+        nodes[lhs].child = rhs;
+        return lhs;
+    }
+
+public:
+    void push(uint32_t key, const Entry &entry) {
+        Node node{key, next_insertion_id++, entry, NONE, NONE};
+        int index;
+        if (free_nodes.empty()) {
+            index = nodes.size();
+            nodes.push_back(move(node));
+        } else {
+            index = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[index] = move(node);
+        }
+        root = meld(root, index);
+        ++num_entries;
+    }
+
+    pair<uint32_t, Entry> pop() {
+        assert(!empty());
+        int old_root = root;
+        // First pass: meld the children of the root in pairs from the left.
+        pairs.clear();
+        int child = nodes[old_root].child;
+        while (child != NONE) {
+            int first = child;
+            int second = nodes[first].sibling;
+            child = second == NONE ? NONE : nodes[second].sibling;
+            nodes[first].sibling = NONE;
+            if (second != NONE)
+                nodes[second].sibling = NONE;
+            pairs.push_back(meld(first, second));
+        }
+        // Second pass: meld the pairs from the right.
+        root = NONE;
+        for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) {
+            root = meld(root, *it);
+        }
+        free_nodes.push_back(old_root);
+        --num_entries;
+        return {nodes[old_root].key, move(nodes[old_root].entry)};
+    }
+
+    bool empty() const {
+        return num_entries == 0;
+    }
+
+    void clear() {
+        nodes.clear();
+        free_nodes.clear();
+        root = NONE;
+        num_entries = 0;
+    }
+};
+}
+
+template<class Entry>
+class RadixHeapOpenList final : public OpenList<Entry> {
+    shared_ptr<Evaluator> evaluator;
+    RadixHeap<Entry> radix_heap;
+    PairingHeap<Entry> fallback_heap;
+    bool use_fallback_heap;
+    utils::LogProxy log;
+    // Avoid allocating buffers for every batch insertion.
+    vector<StateID> batch_state_ids;
+    vector<int> batch_values;
+
+    void switch_to_fallback_heap() {
+        vector<pair<uint32_t, Entry>> entries;
+        radix_heap.extract_all(entries);
+        for (const auto &[key, entry] : entries) {
+            fallback_heap.push(key, entry);
+        }
+        use_fallback_heap = true;
+    }
+
+    void insert_with_key(const Entry &entry, int value) {
+        if (value == Evaluator::INFTY) {
+            return;
+        }
+        assert(value >= 0);
+        uint32_t key = value;
+        if (!use_fallback_heap && key < radix_heap.get_last_key()) {
+            switch_to_fallback_heap();
+        }
+        if (use_fallback_heap) {
+            fallback_heap.push(key, entry);
+        } else {
+            radix_heap.push(key, entry);
+        }
+    }
+
+protected:
+    virtual void do_insertion(const Entry &entry) override {
+        insert_with_key(entry, evaluator->evaluate(get_state_id(entry)));
+    }
+
+    virtual void do_batch_insertion(span<const Entry> entries) override {
+        batch_state_ids.clear();
+        for (const Entry &entry : entries) {
+            batch_state_ids.push_back(get_state_id(entry));
+        }
+        batch_values.resize(entries.size());
+        evaluator->evaluate(batch_state_ids, batch_values);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            insert_with_key(entries[i], batch_values[i]);
+        }
+    }
+
+public:
+    RadixHeapOpenList(
+        const shared_ptr<Evaluator> &eval, bool pref_only,
+        const utils::LogProxy &log)
+        : OpenList<Entry>(pref_only),
+          evaluator(eval),
+          use_fallback_heap(false),
+          log(log) {
+        log << "RadixHeapOpenList_Constructor (NOT factory)" << '\n';
+    }
+
+    virtual Entry remove_min() override {
+        if (use_fallback_heap) {
+            return fallback_heap.pop().second;
+        }
+        return radix_heap.pop().second;
+    }
+
+    virtual bool empty() const override {
+        return use_fallback_heap ? fallback_heap.empty() : radix_heap.empty();
+    }
+
+    virtual void clear() override {
+        radix_heap.clear();
+        fallback_heap.clear();
+        use_fallback_heap = false;
+    }
+
+    virtual void get_involved_evaluators(set<Evaluator *> &evals) override {
+        evaluator->get_involved_evaluators(evals);
+    }
+
+    void dump() override {
+        log << "RadixHeapOpenList(NOT factory) with eval: ";
+        evaluator->dump();
+        log << '\n';
+    }
+};
+
+RadixHeapOpenListFactory::RadixHeapOpenListFactory(
+    const shared_ptr<AbstractTask> &task, const shared_ptr<Evaluator> &eval,
+    bool pref_only, const string &description, utils::Verbosity verbosity)
+    : OpenListFactory(task, verbosity), eval(eval), pref_only(pref_only) {
+    log << "RadixHeapOpenListFactory_Constructor" << '\n';
+}
+
+unique_ptr<StateOpenList> RadixHeapOpenListFactory::create_state_open_list() {
+    return make_unique<RadixHeapOpenList<StateOpenListEntry>>(
+        eval, pref_only, log);
+}
+
+unique_ptr<EdgeOpenList> RadixHeapOpenListFactory::create_edge_open_list() {
+    return make_unique<RadixHeapOpenList<EdgeOpenListEntry>>(
+        eval, pref_only, log);
+}
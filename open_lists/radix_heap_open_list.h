@@ -0,0 +1,33 @@
+#ifndef OPEN_LISTS_RADIX_HEAP_OPEN_LIST_H
+#define OPEN_LISTS_RADIX_HEAP_OPEN_LIST_H
+
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+
+/*
+  Open lists ordered by the value of a single evaluator, for keys that can
+  span a wide range (e.g. f-values with large action costs) where dense
+  bucket arrays would waste memory.
+
+  As long as keys are monotone (no inserted key is smaller than the last
+  removed one), the open list is a radix heap with one bucket per bit of the
+  key. When a smaller key is inserted, e.g. because the evaluator is
+  inconsistent, it permanently switches to a pairing heap. Entries with an
+  infinite value are dead ends and are not stored.
+*/
+class RadixHeapOpenListFactory : public OpenListFactory {
+    std::shared_ptr<Evaluator> eval;
+    bool pref_only;
+public:
+    static constexpr bool task_independent = true;
+
+    RadixHeapOpenListFactory(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::shared_ptr<Evaluator> &eval, bool pref_only,
+        const std::string &description, utils::Verbosity verbosity);
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+
+#endif
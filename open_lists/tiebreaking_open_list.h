@@ -2,13 +2,247 @@
 #define OPEN_LISTS_TIEBREAKING_OPEN_LIST_H
 
 #include "../evaluator.h"
+#include "../open_list.h"
 #include "../open_list_factory.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+/*
+  Open list ordered lexicographically by the values of its evaluators, with
+  ties broken in FIFO order.
+
+  Evaluator values are small non-negative integers, so instead of a
+  comparison-based heap we use nested bucket arrays: level i of the
+  structure is indexed by the value of the i-th evaluator, and the last level
+  holds the entries in FIFO order. Each level remembers a lower bound on its
+  smallest non-empty index. Inserting is O(number of evaluators), and
+  removing the minimum is amortized O(number of evaluators) as long as keys
+  do not drop far below the last removed key, which holds for the monotone
+  and near-monotone keys of typical searches.
+
+  Infinite values cannot be used as indices. Each level stores the entries
+  with an infinite value in a separate child behind all finite values.
+
+  The class is final and defined in the header so that search algorithms
+  specialized for it (see EagerSearch) can inline its methods.
+*/
+template<class Entry>
+class TieBreakingOpenList final : public OpenList<Entry> {
+    struct Node {
+        // Number of entries stored below this node.
+        int size = 0;
+
+        // Inner nodes: children indexed by the value of the next evaluator.
+        std::vector<Node> children;
+        std::unique_ptr<Node> infinite_child;
+        // No child with an index below lowest is non-empty.
+        int lowest = 0;
+
+        // Leaf nodes: entries in FIFO order, starting at position head.
+        std::vector<Entry> entries;
+        std::size_t head = 0;
+
+        void push(const Entry &entry) {
+            entries.push_back(entry);
+        }
+
+        Entry pop() {
+            assert(head < entries.size());
+            Entry entry = entries[head++];
+            if (head == entries.size()) {
+                entries.clear();
+                head = 0;
+            } else if (head >= 64 && 2 * head >= entries.size()) {
+                // Release the popped prefix without losing amortized O(1).
+                entries.erase(entries.begin(), entries.begin() + head);
+                head = 0;
+            }
+            return entry;
+        }
+
+        Node &get_child(int value) {
+            if (value == Evaluator::INFTY) {
+                if (!infinite_child) {
+                    infinite_child = std::make_unique<Node>();
+                }
+                return *infinite_child;
+            }
+            assert(value >= 0);
+            if (value >= static_cast<int>(children.size())) {
+                children.resize(value + 1);
+            }
+            lowest = std::min(lowest, value);
+            return children[value];
+        }
+
+        Node &get_min_child() {
+            int num_children = children.size();
+            while (lowest < num_children && children[lowest].size == 0) {
+                ++lowest;
+            }
+            if (lowest < num_children) {
+                return children[lowest];
+            }
+            assert(infinite_child && infinite_child->size > 0);
+            return *infinite_child;
+        }
+    };
+
+    std::vector<std::shared_ptr<Evaluator>> evaluators;
+    bool allow_unsafe_pruning;
+    utils::LogProxy log;
+
+    Node root;
+    // Avoid allocating key vectors for every insertion.
+    std::vector<int> key;
+    std::vector<StateID> batch_state_ids;
+    std::vector<int> batch_values;
+
+    bool is_dead_end(const std::vector<int> &key) const;
+    void insert_with_key(const Entry &entry, const std::vector<int> &key);
+
+protected:
+    virtual void do_insertion(const Entry &entry) override;
+    virtual void do_batch_insertion(std::span<const Entry> entries) override;
+
+public:
+    TieBreakingOpenList(
+        const std::vector<std::shared_ptr<Evaluator>> &evals,
+        bool unsafe_pruning, bool pref_only, const utils::LogProxy &log);
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+
+    virtual void get_involved_evaluators(
+        std::set<Evaluator *> &evals) override {
+        for (const std::shared_ptr<Evaluator> &evaluator : evaluators) {
+            evaluator->get_involved_evaluators(evals);
+        }
+    }
+
+    void dump() override {
+        log << "TBOpenList(NOT factory) with evals:\n\n";
+        for (auto eval : evaluators) {
+            log << "TBOL_eval: ";
+            eval->dump();
+            log << '\n';
+        }
+    }
+};
+
+template<class Entry>
+TieBreakingOpenList<Entry>::TieBreakingOpenList(
+    const std::vector<std::shared_ptr<Evaluator>> &evals,
+    bool unsafe_pruning, bool pref_only, const utils::LogProxy &log)
+    : OpenList<Entry>(pref_only),
+      evaluators(evals),
+      allow_unsafe_pruning(unsafe_pruning),
+      log(log),
+      key(evals.size()) {
+    log << "TieBreakingOpenList_Constructor (NOT factory)" << '\n';
+}
+
+template<class Entry>
+bool TieBreakingOpenList<Entry>::is_dead_end(
+    const std::vector<int> &key) const {
+    if (key.empty()) {
+        return false;
+    }
+    // If the first evaluator detects a dead end and we allow "unsafe
+    // pruning", the entry is a dead end.
+    if (allow_unsafe_pruning && key[0] == Evaluator::INFTY) {
+        return true;
+    }
+    // Otherwise, all evaluators have to agree that the entry is a dead end.
+    return std::all_of(key.begin(), key.end(), [](int value) {
+        return value == Evaluator::INFTY;
+    });
+}
+
+template<class Entry>
+void TieBreakingOpenList<Entry>::insert_with_key(
+    const Entry &entry, const std::vector<int> &key) {
+    if (is_dead_end(key)) {
+        return;
+    }
+    Node *node = &root;
+    for (int value : key) {
+        ++node->size;
+        node = &node->get_child(value);
+    }
+    ++node->size;
+    node->push(entry);
+}
+
+template<class Entry>
+void TieBreakingOpenList<Entry>::do_insertion(const Entry &entry) {
+    StateID state_id = get_state_id(entry);
+    for (std::size_t i = 0; i < evaluators.size(); ++i) {
+        key[i] = evaluators[i]->evaluate(state_id);
+    }
+    insert_with_key(entry, key);
+}
+
+template<class Entry>
+void TieBreakingOpenList<Entry>::do_batch_insertion(
+    std::span<const Entry> entries) {
+    std::size_t num_entries = entries.size();
+    batch_state_ids.clear();
+    for (const Entry &entry : entries) {
+        batch_state_ids.push_back(get_state_id(entry));
+    }
+    // Values of evaluator i are in [i * num_entries, (i + 1) * num_entries).
+    batch_values.resize(evaluators.size() * num_entries);
+    for (std::size_t i = 0; i < evaluators.size(); ++i) {
+        evaluators[i]->evaluate(
+            batch_state_ids,
+            std::span<int>(batch_values.data() + i * num_entries, num_entries));
+    }
+    for (std::size_t j = 0; j < num_entries; ++j) {
+        for (std::size_t i = 0; i < evaluators.size(); ++i) {
+            key[i] = batch_values[i * num_entries + j];
+        }
+        insert_with_key(entries[j], key);
+    }
+}
+
+template<class Entry>
+Entry TieBreakingOpenList<Entry>::remove_min() {
+    assert(!empty());
+    Node *node = &root;
+    for (std::size_t i = 0; i < evaluators.size(); ++i) {
+        --node->size;
+        node = &node->get_min_child();
+    }
+    --node->size;
+    return node->pop();
+}
+
+template<class Entry>
+bool TieBreakingOpenList<Entry>::empty() const {
+    return root.size == 0;
+}
+
+template<class Entry>
+void TieBreakingOpenList<Entry>::clear() {
+    root = Node();
+}
+
+
 class TieBreakingOpenListFactory : public OpenListFactory {
     std::vector<std::shared_ptr<Evaluator>> evals;
     bool unsafe_pruning;
     bool pref_only;
 public:
+    static constexpr bool task_independent = true;
+
     TieBreakingOpenListFactory(
         const std::shared_ptr<AbstractTask> &task,
         const std::vector<std::shared_ptr<Evaluator>> &evals,
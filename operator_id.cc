@@ -1 +1,12 @@
 #include "operator_id.h"
+
+#include <ostream>
+
+using namespace std;
+
+const OperatorID OperatorID::no_operator = OperatorID(-1);
+
+ostream &operator<<(ostream &os, OperatorID id) {
+    os << "op" << id.get_index();
+    return os;
+}
@@ -4,19 +4,39 @@
 #include "../utils/tuples.h"
 
 #include <memory>
+#include <tuple>
+#include <utility>
 
 namespace plugins {
-    template<typename T, typename... Arguments>
-std::shared_ptr<T> make_shared_from_arg_tuples(Arguments... arguments) {
+/*
+  Construct a T from the given arguments after flattening nested tuples.
+  Arguments are forwarded all the way to the constructor, so bound
+  arguments passed as rvalues are moved rather than copied.
+*/
+template<typename T, typename... Arguments>
+std::shared_ptr<T> make_shared_from_arg_tuples(Arguments &&...arguments) {
     return std::apply(
         [](auto &&...flattened_args) {
             return std::make_shared<T>(
                 std::forward<decltype(flattened_args)>(flattened_args)...);
         },
         utils::flatten_tuple(
-            std::tuple<Arguments...>(std::forward<Arguments>(arguments)...)));
+            std::forward_as_tuple(std::forward<Arguments>(arguments)...)));
+}
 
+// Like make_shared_from_arg_tuples, but allocate with the given allocator.
+template<typename T, typename Allocator, typename... Arguments>
+std::shared_ptr<T> allocate_shared_from_arg_tuples(
+    const Allocator &allocator, Arguments &&...arguments) {
+    return std::apply(
+        [&allocator](auto &&...flattened_args) {
+            return std::allocate_shared<T>(
+                allocator,
+                std::forward<decltype(flattened_args)>(flattened_args)...);
+        },
+        utils::flatten_tuple(
+            std::forward_as_tuple(std::forward<Arguments>(arguments)...)));
 }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,167 @@
+#include "portfolio_runner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using namespace std;
+
+namespace portfolio_runner {
+namespace {
+class TaskQueue {
+    deque<size_t> task_indices;
+    mutex queue_mutex;
+public:
+    void push(size_t task_index) {
+        lock_guard<mutex> lock(queue_mutex);
+        task_indices.push_back(task_index);
+    }
+
+    // The owner takes tasks from the front...
+    optional<size_t> pop() {
+        lock_guard<mutex> lock(queue_mutex);
+        if (task_indices.empty()) {
+            return nullopt;
+        }
+        size_t task_index = task_indices.front();
+        task_indices.pop_front();
+        return task_index;
+    }
+
+    // ...and thieves from the back, so that they rarely compete.
+    optional<size_t> steal() {
+        lock_guard<mutex> lock(queue_mutex);
+        if (task_indices.empty()) {
+            return nullopt;
+        }
+        size_t task_index = task_indices.back();
+        task_indices.pop_back();
+        return task_index;
+    }
+};
+
+double get_elapsed_seconds(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+TaskResult run_task(
+    const TaskIndependentComponent<SearchAlgorithm> &search_component,
+    const shared_ptr<AbstractTask> &task, size_t task_index,
+    size_t memory_limit, Cache &task_independent_cache) {
+    TaskResult result;
+    result.task_index = task_index;
+    try {
+        auto start = chrono::steady_clock::now();
+        Cache cache(nullptr, &task_independent_cache);
+        shared_ptr<SearchAlgorithm> search =
+            search_component.bind_task(task, cache);
+        result.bind_time = get_elapsed_seconds(start);
+        search->set_memory_limit(memory_limit);
+        search->search();
+        result.status = search->get_status();
+        result.plan = search->get_plan();
+        result.search_time = get_elapsed_seconds(start) - result.bind_time;
+        result.num_bytes = search->get_num_bytes();
+    } catch (const exception &e) {
+        result.status = ERROR;
+        result.error = e.what();
+    }
+    return result;
+}
+}
+
+void PortfolioStatistics::print(const utils::LogProxy &log) const {
+    log << "Portfolio tasks: " << num_tasks << '\n';
+    log << "Solved: " << num_solved << ", failed: " << num_failed
+        << ", out of memory: " << num_out_of_memory
+        << ", errors: " << num_errors << '\n';
+    log << "Portfolio wall time: " << wall_time << "s" << '\n';
+    log << "Tasks per second: " << get_tasks_per_second() << '\n';
+}
+
+PortfolioRunner::PortfolioRunner(
+    int num_workers, size_t memory_limit_per_worker)
+    : num_workers(max(num_workers, 1)),
+      memory_limit_per_worker(memory_limit_per_worker) {
+}
+
+PortfolioStatistics PortfolioRunner::run(
+    const shared_ptr<TaskIndependentComponent<SearchAlgorithm>>
+        &search_component,
+    const vector<shared_ptr<AbstractTask>> &tasks,
+    const ResultCallback &callback) {
+    auto start = chrono::steady_clock::now();
+    int num_threads = min<size_t>(num_workers, max<size_t>(tasks.size(), 1));
+
+    // Give each worker a contiguous block of tasks.
+    vector<TaskQueue> queues(num_threads);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        queues[i * num_threads / tasks.size()].push(i);
+    }
+
+    // Components that do not depend on the task are bound only once.
+    Cache task_independent_cache;
+
+    PortfolioStatistics statistics;
+    statistics.num_tasks = tasks.size();
+    mutex result_mutex;
+    auto report = [&](const TaskResult &result) {
+        lock_guard<mutex> lock(result_mutex);
+        switch (result.status) {
+        case SOLVED:
+            ++statistics.num_solved;
+            break;
+        case FAILED:
+            ++statistics.num_failed;
+            break;
+        case OUT_OF_MEMORY:
+            ++statistics.num_out_of_memory;
+            break;
+        case ERROR:
+            ++statistics.num_errors;
+            break;
+        case IN_PROGRESS:
+            // run_task only returns finished searches.
+            assert(false);
+            break;
+        }
+        callback(result);
+    };
+
+    auto work = [&](int worker) {
+        while (true) {
+            optional<size_t> task_index = queues[worker].pop();
+            for (int i = 1; !task_index && i < num_threads; ++i) {
+                task_index = queues[(worker + i) % num_threads].steal();
+            }
+            /*
+              Tasks are never added after the start, so if all queues are
+              empty, we are done.
+            */
+            if (!task_index) {
+                return;
+            }
+            report(run_task(
+                *search_component, tasks[*task_index], *task_index,
+                memory_limit_per_worker, task_independent_cache));
+        }
+    };
+
+    vector<thread> threads;
+    threads.reserve(num_threads);
+    for (int worker = 0; worker < num_threads; ++worker) {
+        threads.emplace_back(work, worker);
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    statistics.wall_time = get_elapsed_seconds(start);
+    return statistics;
+}
+}
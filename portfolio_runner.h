@@ -0,0 +1,74 @@
+#ifndef PORTFOLIO_RUNNER_H
+#define PORTFOLIO_RUNNER_H
+
+#include "component.h"
+#include "search_algorithm.h"
+
+#include "utils/logging.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace portfolio_runner {
+struct TaskResult {
+    // Position of the task in the list passed to PortfolioRunner::run.
+    std::size_t task_index = 0;
+    SearchStatus status = IN_PROGRESS;
+    Plan plan;
+    double bind_time = 0;
+    double search_time = 0;
+    std::size_t num_bytes = 0;
+    // The message of the exception if the status is ERROR.
+    std::string error;
+};
+
+struct PortfolioStatistics {
+    std::size_t num_tasks = 0;
+    std::size_t num_solved = 0;
+    std::size_t num_failed = 0;
+    std::size_t num_out_of_memory = 0;
+    std::size_t num_errors = 0;
+    double wall_time = 0;
+
+    double get_tasks_per_second() const {
+        return wall_time > 0 ? num_tasks / wall_time : 0;
+    }
+
+    void print(const utils::LogProxy &log) const;
+};
+
+using ResultCallback = std::function<void(const TaskResult &)>;
+
+/*
+  Bind one search configuration to many tasks and run the searches in
+  parallel.
+
+  Every task is bound with its own Cache and searched on one of the worker
+  threads. Task-independent components are bound once and shared by all
+  tasks. Tasks are distributed over per-worker queues up front; a worker
+  that runs out of tasks steals from the back of another worker's queue, so
+  tasks with very different run times still keep all workers busy. Each
+  search is stopped with OUT_OF_MEMORY when it exceeds the per-worker memory
+  limit.
+
+  Results are passed to the callback as soon as a task finishes, in
+  completion order. The callback is never called concurrently.
+*/
+class PortfolioRunner {
+    int num_workers;
+    std::size_t memory_limit_per_worker;
+public:
+    PortfolioRunner(int num_workers, std::size_t memory_limit_per_worker);
+
+    PortfolioStatistics run(
+        const std::shared_ptr<TaskIndependentComponent<SearchAlgorithm>>
+            &search_component,
+        const std::vector<std::shared_ptr<AbstractTask>> &tasks,
+        const ResultCallback &callback);
+};
+}
+
+#endif
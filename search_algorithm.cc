@@ -0,0 +1,19 @@
+#include "search_algorithm.h"
+
+#include <chrono>
+
+using namespace std;
+
+void SearchAlgorithm::search() {
+    auto start_time = chrono::steady_clock::now();
+    initialize();
+    while (status == IN_PROGRESS) {
+        status = step();
+        if (status == IN_PROGRESS && get_num_bytes() > memory_limit) {
+            log << "Memory limit reached." << '\n';
+            status = OUT_OF_MEMORY;
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+    search_time = elapsed.count();
+}
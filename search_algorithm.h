@@ -2,15 +2,87 @@
 #define SEARCH_ALGORITHM_H
 
 #include "component.h"
+#include "search_space.h"
 #include "utils/logging.h"
 
-#include <iostream>
+#include <cstddef>
+#include <limits>
+
+enum SearchStatus {
+    IN_PROGRESS,
+    FAILED,
+    SOLVED,
+    OUT_OF_MEMORY,
+    // The search or the binding of its components threw an exception.
+    ERROR
+};
 
 class SearchAlgorithm : public TaskSpecificComponent {
+    SearchStatus status;
+    Plan plan;
+    double search_time;
+    std::size_t memory_limit;
+protected:
+    mutable utils::LogProxy log;
+
+    virtual void initialize() {
+    }
+    virtual SearchStatus step() = 0;
+
+    void set_plan(const Plan &new_plan) {
+        plan = new_plan;
+    }
+
+    double get_search_time() const {
+        return search_time;
+    }
 public:
-    SearchAlgorithm(const std::shared_ptr<AbstractTask> &task)
-    : TaskSpecificComponent(task) {
+    SearchAlgorithm(
+        const std::shared_ptr<AbstractTask> &task, utils::Verbosity verbosity)
+    : TaskSpecificComponent(task),
+      status(IN_PROGRESS),
+      search_time(0),
+      memory_limit(std::numeric_limits<std::size_t>::max()),
+      log(verbosity) {
+    }
+
+    /*
+      Run initialize() and then step() until the search is solved or fails,
+      or until get_num_bytes() exceeds the memory limit.
+    */
+    void search();
+
+    /*
+      Stop the search with status OUT_OF_MEMORY once it uses more than
+      num_bytes. This allows running several searches side by side without
+      one of them exhausting the memory of the others.
+    */
+    void set_memory_limit(std::size_t num_bytes) {
+        memory_limit = num_bytes;
+    }
+
+    /*
+      Return the number of bytes used by the data structures that grow
+      during the search. This is checked after every step, so it has to be
+      cheap.
+    */
+    virtual std::size_t get_num_bytes() const {
+        return 0;
+    }
+
+    SearchStatus get_status() const {
+        return status;
     }
+
+    bool found_solution() const {
+        return status == SOLVED;
+    }
+
+    const Plan &get_plan() const {
+        return plan;
+    }
+
+    virtual void print_statistics() const = 0;
     virtual void dump() = 0;
 };
 
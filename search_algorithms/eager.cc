@@ -4,11 +4,20 @@
 #include "../evaluator.h"
 #include "../open_list_factory.h"
 
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/linear_combination_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../open_lists/tiebreaking_open_list.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
 #include <optional>
 #include <set>
+#include <type_traits>
+#include <variant>
 
 using namespace std;
 
@@ -18,5 +27,242 @@ EagerSearch::EagerSearch(
     const shared_ptr<OpenListFactory> &open,
     const shared_ptr<Evaluator> &f_eval, const string &description,
     utils::Verbosity verbosity)
-    : SearchAlgorithm(task), f_evaluator(f_eval), open_list(open->create_state_open_list()){};
+    : SearchAlgorithm(task, verbosity),
+      open_list(open->create_state_open_list()),
+      f_evaluator(f_eval),
+      state_registry(task_proxy),
+      successor_generator(task_proxy),
+      goals(task_proxy.get_goals()),
+      last_reported_f(-1) {
+}
+
+void EagerSearch::specialize_search_loop() {
+    using TieBreakingStateOpenList = TieBreakingOpenList<StateOpenListEntry>;
+    if (auto open = dynamic_cast<TieBreakingStateOpenList *>(open_list.get())) {
+        specialized_open_list = open;
+    } else {
+        specialized_open_list = open_list.get();
+    }
+    Evaluator *f_eval = f_evaluator.get();
+    // Constant values stored in a cache still have to go through it.
+    auto const_eval = dynamic_cast<const_evaluator::ConstEvaluator *>(f_eval);
+    if (const_eval && !const_eval->uses_value_cache()) {
+        specialized_f_evaluator = const_eval;
+    } else if (auto eval = dynamic_cast<LinearCombinationEvaluator *>(f_eval)) {
+        specialized_f_evaluator = eval;
+    } else if (auto eval = dynamic_cast<SumEvaluator *>(f_eval)) {
+        /*
+          Binding folds sums and weighted evaluators into linear
+          combinations, but evaluators created without binding keep their
+          type.
+        */
+        specialized_f_evaluator = eval;
+    } else if (auto eval = dynamic_cast<WeightedEvaluator *>(f_eval)) {
+        specialized_f_evaluator = eval;
+    } else {
+        specialized_f_evaluator = f_eval;
+    }
+}
+
+bool EagerSearch::is_goal_state(const vector<int> &values) const {
+    for (const FactPair &goal : goals) {
+        if (values[goal.var] != goal.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EagerSearch::report_f_value_progress(int f) {
+    if (f > last_reported_f) {
+        last_reported_f = f;
+        log << "f = " << f << " [" << statistics.expanded << " expanded, "
+            << statistics.generated << " generated]" << '\n';
+    }
+}
+
+void EagerSearch::initialize() {
+    /*
+      Caches may be enabled until the search starts, so we choose the
+      specialization here rather than in the constructor.
+    */
+    specialize_search_loop();
+    set<Evaluator *> evaluators;
+    f_evaluator->get_involved_evaluators(evaluators);
+    open_list->get_involved_evaluators(evaluators);
+    for (Evaluator *evaluator : evaluators) {
+        if (evaluator->uses_value_cache()) {
+            // Cached values of a previous search refer to another registry.
+            evaluator->clear_value_cache();
+            cached_evaluators.push_back(evaluator);
+        }
+    }
+
+    StateID initial_state = state_registry.get_initial_state();
+    ++statistics.evaluated;
+    int f = f_evaluator->evaluate(initial_state);
+    if (f == Evaluator::INFTY) {
+        log << "Initial state is a dead end." << '\n';
+        search_space.mark_as_dead_end(initial_state);
+        ++statistics.dead_ends;
+        return;
+    }
+    search_space.open_initial(initial_state);
+    search_space.set_f(initial_state, f);
+    open_list->insert(initial_state);
+}
+
+template<class OpenListType>
+optional<StateID> EagerSearch::fetch_next_state(OpenListType &open) {
+    while (!open.empty()) {
+        StateID id = open.remove_min();
+        /*
+          The open list may contain several entries for the same state if it
+          was reopened. Only the first one is expanded; the state is closed
+          afterwards, so we skip the others here.
+        */
+        if (search_space.get_status(id) == NodeStatus::OPEN) {
+            return id;
+        }
+    }
+    return nullopt;
+}
+
+SearchStatus EagerSearch::step() {
+    return visit(
+        [this](auto *open, auto *f_eval) {
+            return expand_next_state(*open, *f_eval);
+        },
+        specialized_open_list, specialized_f_evaluator);
+}
+
+template<class OpenListType, class FEvaluatorType>
+SearchStatus EagerSearch::expand_next_state(
+    OpenListType &open, FEvaluatorType &f_eval) {
+    optional<StateID> next = fetch_next_state(open);
+    if (!next) {
+        log << "Completely explored state space -- no solution!" << '\n';
+        return FAILED;
+    }
+    StateID id = *next;
+    state_registry.unpack_state(id, current_values);
+    if (is_goal_state(current_values)) {
+        log << "Solution found!" << '\n';
+        Plan plan;
+        search_space.trace_path(id, plan);
+        set_plan(plan);
+        return SOLVED;
+    }
+
+    report_f_value_progress(search_space.get_f(id));
+    search_space.close(id);
+    for (Evaluator *evaluator : cached_evaluators) {
+        evaluator->evict_cached_value(id);
+    }
+    ++statistics.expanded;
+
+    int g = search_space.get_g(id);
+    applicable_ops.clear();
+    successor_generator.generate_applicable_ops(current_values, applicable_ops);
+    new_states.clear();
+    successors.clear();
+    for (OperatorID op : applicable_ops) {
+        successor_values = current_values;
+        successor_generator.apply_operator(op, successor_values);
+        StateID succ_id = state_registry.insert_state(successor_values);
+        ++statistics.generated;
+        int succ_g = g + successor_generator.get_operator_cost(op);
+
+        NodeStatus succ_status = search_space.get_status(succ_id);
+        if (succ_status == NodeStatus::DEAD_END) {
+            continue;
+        }
+        if (succ_status == NodeStatus::NEW) {
+            /*
+              Open the state right away, so that reaching it again in this
+              expansion counts as a duplicate. It is evaluated with the other
+              new states below.
+            */
+            search_space.open(succ_id, succ_g, id, op);
+            new_states.push_back(succ_id);
+            successors.push_back(succ_id);
+        } else if (succ_g < search_space.get_g(succ_id)) {
+            // We found a cheaper path to an open or closed state.
+            if (succ_status == NodeStatus::CLOSED) {
+                ++statistics.reopened;
+            }
+            /*
+              If the state is already a successor of this expansion, only
+              its path changes. This is rare, so a linear search is fine.
+            */
+            bool is_successor =
+                succ_status == NodeStatus::OPEN &&
+                find(successors.begin(), successors.end(), succ_id) !=
+                successors.end();
+            search_space.open(succ_id, succ_g, id, op);
+            if (!is_successor) {
+                successors.push_back(succ_id);
+            }
+        }
+    }
+
+    statistics.evaluated += new_states.size();
+    if constexpr (is_same_v<FEvaluatorType, const_evaluator::ConstEvaluator>) {
+        /*
+          The f-value is finite, otherwise the initial state would have been
+          a dead end, and it is the same for all states.
+        */
+        for (StateID id : new_states) {
+            search_space.set_f(id, f_eval.get_value());
+        }
+    } else {
+        // Evaluate all new successors with one call per evaluator.
+        new_state_f_values.resize(new_states.size());
+        f_eval.evaluate(new_states, new_state_f_values);
+        for (size_t i = 0; i < new_states.size(); ++i) {
+            if (new_state_f_values[i] == Evaluator::INFTY) {
+                search_space.mark_as_dead_end(new_states[i]);
+                ++statistics.dead_ends;
+            } else {
+                search_space.set_f(new_states[i], new_state_f_values[i]);
+            }
+        }
+    }
+    // Insert the states in the order in which they were generated.
+    states_to_insert.clear();
+    for (StateID id : successors) {
+        if (search_space.get_status(id) != NodeStatus::DEAD_END) {
+            states_to_insert.push_back(id);
+        }
+    }
+    open.insert(span<const StateID>(states_to_insert));
+    return IN_PROGRESS;
+}
+
+size_t EagerSearch::get_num_bytes() const {
+    return state_registry.get_num_bytes() + search_space.get_num_bytes();
+}
+
+void EagerSearch::print_statistics() const {
+    log << "Expanded " << statistics.expanded << " state(s)." << '\n';
+    log << "Reopened " << statistics.reopened << " state(s)." << '\n';
+    log << "Evaluated " << statistics.evaluated << " state(s)." << '\n';
+    log << "Generated " << statistics.generated << " state(s)." << '\n';
+    log << "Dead ends: " << statistics.dead_ends << " state(s)." << '\n';
+    double search_time = get_search_time();
+    log << "Search time: " << search_time << "s" << '\n';
+    if (search_time > 0) {
+        log << "Expansions per second: "
+            << static_cast<long long>(statistics.expanded / search_time)
+            << '\n';
+    }
+    for (const Evaluator *evaluator : cached_evaluators) {
+        log << "Value cache of " << evaluator->get_description() << ": "
+            << evaluator->get_cache_hits() << " hits, "
+            << evaluator->get_cache_misses() << " misses" << '\n';
+    }
+    state_registry.print_statistics(log);
+    log << "Search space memory: " << search_space.get_num_bytes()
+        << " bytes" << '\n';
+}
 }
@@ -1,22 +1,104 @@
-
 #ifndef SEARCH_ALGORITHMS_EAGER_SEARCH_H
 #define SEARCH_ALGORITHMS_EAGER_SEARCH_H
 
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../search_algorithm.h"
+#include "../search_space.h"
+#include "../state_registry.h"
+
+#include "../task_utils/successor_generator.h"
 
 #include <memory>
 #include <optional>
+#include <variant>
 #include <vector>
 
 class OpenListFactory;
+template<class Entry>
+class TieBreakingOpenList;
+
+class LinearCombinationEvaluator;
+class SumEvaluator;
+class WeightedEvaluator;
+
+namespace const_evaluator {
+class ConstEvaluator;
+}
 
 namespace eager_search {
+struct SearchStatistics {
+    long long expanded = 0;
+    long long generated = 0;
+    long long evaluated = 0;
+    long long reopened = 0;
+    long long dead_ends = 0;
+};
+
+/*
+  Best-first search that evaluates states when they are generated. The open
+  list determines the expansion order. States are reopened if they are
+  reached on a cheaper path, and the f-evaluator is used for detecting dead
+  ends and reporting progress. Each state is evaluated with it only once,
+  when it is first generated, and its value is stored in the search space.
 
+  The search loop is a template over the concrete types of the open list and
+  the f-evaluator. For common configurations we instantiate it with the
+  concrete (final) classes, so that the compiler can inline their methods
+  and call compute_values of the f-evaluator directly: tie-breaking open
+  lists, and f-evaluators that are constants, linear combinations (the
+  usual result of bind-time folding, e.g. for g + w * h), sums or weighted
+  evaluators. All other configurations use the virtual interfaces.
+*/
 class EagerSearch : public SearchAlgorithm {
     std::unique_ptr<StateOpenList> open_list;
     std::shared_ptr<Evaluator> f_evaluator;
+
+    StateRegistry state_registry;
+    SearchSpace search_space;
+    successor_generator::SuccessorGenerator successor_generator;
+    std::vector<FactPair> goals;
+
+    /*
+      The open list and f-evaluator as passed to the search loop. The first
+      alternative of each variant is the generic one.
+    */
+    using OpenListVariant = std::variant<
+        StateOpenList *, TieBreakingOpenList<StateOpenListEntry> *>;
+    using FEvaluatorVariant = std::variant<
+        Evaluator *, const_evaluator::ConstEvaluator *,
+        LinearCombinationEvaluator *, SumEvaluator *, WeightedEvaluator *>;
+    OpenListVariant specialized_open_list;
+    FEvaluatorVariant specialized_f_evaluator;
+
+    // Evaluators with a value cache, from which we evict closed states.
+    std::vector<Evaluator *> cached_evaluators;
+
+    SearchStatistics statistics;
+    int last_reported_f;
+
+    // Reused buffers to avoid allocations in the search loop.
+    std::vector<int> current_values;
+    std::vector<int> successor_values;
+    std::vector<OperatorID> applicable_ops;
+    // Successors of an expansion in generation order, without duplicates.
+    std::vector<StateID> successors;
+    // Successors that were generated for the first time.
+    std::vector<StateID> new_states;
+    std::vector<int> new_state_f_values;
+    std::vector<StateID> states_to_insert;
+
+    bool is_goal_state(const std::vector<int> &values) const;
+    void specialize_search_loop();
+    template<class OpenListType>
+    std::optional<StateID> fetch_next_state(OpenListType &open);
+    template<class OpenListType, class FEvaluatorType>
+    SearchStatus expand_next_state(
+        OpenListType &open, FEvaluatorType &f_eval);
+    void report_f_value_progress(int f);
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
 public:
     explicit EagerSearch(
         const std::shared_ptr<AbstractTask> &,
@@ -24,11 +106,14 @@ public:
         const std::shared_ptr<Evaluator> &f_eval,
         const std::string &description, utils::Verbosity verbosity);
 
+    virtual std::size_t get_num_bytes() const override;
+    virtual void print_statistics() const override;
+
     void dump() override {
-        std::cout << "eager"
-                  << " with f-eval and open_list:\n f-eval:" << std::endl;
+        log << "eager"
+            << " with f-eval and open_list:\n f-eval:" << '\n';
         f_evaluator->dump();
-        std::cout << " open_list:" << std::endl;
+        log << " open_list:" << '\n';
         open_list->dump();
     }
 };
@@ -0,0 +1,59 @@
+#include "search_space.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+void SearchSpace::ensure_capacity(StateID id) {
+    size_t new_size = id.get_value() + 1;
+    if (new_size > statuses.size()) {
+        statuses.resize(new_size, NodeStatus::NEW);
+        g_values.resize(new_size, -1);
+        f_values.resize(new_size, -1);
+        parents.resize(new_size, StateID::no_state);
+        creating_operators.resize(new_size, OperatorID::no_operator);
+    }
+}
+
+void SearchSpace::open_initial(StateID id) {
+    ensure_capacity(id);
+    assert(statuses[id.get_value()] == NodeStatus::NEW);
+    statuses[id.get_value()] = NodeStatus::OPEN;
+    g_values[id.get_value()] = 0;
+}
+
+void SearchSpace::open(StateID id, int g, StateID parent, OperatorID op) {
+    ensure_capacity(id);
+    assert(statuses[id.get_value()] != NodeStatus::DEAD_END);
+    statuses[id.get_value()] = NodeStatus::OPEN;
+    g_values[id.get_value()] = g;
+    parents[id.get_value()] = parent;
+    creating_operators[id.get_value()] = op;
+}
+
+void SearchSpace::close(StateID id) {
+    assert(statuses[id.get_value()] == NodeStatus::OPEN);
+    statuses[id.get_value()] = NodeStatus::CLOSED;
+}
+
+void SearchSpace::mark_as_dead_end(StateID id) {
+    ensure_capacity(id);
+    statuses[id.get_value()] = NodeStatus::DEAD_END;
+}
+
+void SearchSpace::trace_path(StateID goal_id, Plan &plan) const {
+    assert(plan.empty());
+    StateID current = goal_id;
+    while (parents[current.get_value()] != StateID::no_state) {
+        plan.push_back(creating_operators[current.get_value()]);
+        current = parents[current.get_value()];
+    }
+    reverse(plan.begin(), plan.end());
+}
+
+size_t SearchSpace::get_num_bytes() const {
+    return statuses.get_num_bytes() + g_values.get_num_bytes() +
+           f_values.get_num_bytes() + parents.get_num_bytes() +
+           creating_operators.get_num_bytes();
+}
@@ -0,0 +1,101 @@
+#ifndef SEARCH_SPACE_H
+#define SEARCH_SPACE_H
+
+#include "operator_id.h"
+#include "state_id.h"
+
+#include "algorithms/segmented_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class NodeStatus : std::uint8_t {
+    NEW,
+    OPEN,
+    CLOSED,
+    DEAD_END
+};
+
+using Plan = std::vector<OperatorID>;
+
+/*
+  Per-state search information (status, g-value, f-value, parent state and
+  creating operator), indexed by StateID.
+
+  We store each kind of information in its own segmented vector
+  ("structure of arrays") rather than one node object per state. The search
+  loop mostly looks at statuses and g-values, which are then densely packed
+  in memory, and parent pointers are only touched when opening states and
+  extracting a plan.
+
+  The vectors grow on demand when a state with a higher ID than all
+  previously seen ones is accessed. Since the registry hands out IDs
+  consecutively, this is at most one new entry per newly registered state.
+*/
+class SearchSpace {
+    segmented_vector::SegmentedVector<NodeStatus> statuses;
+    segmented_vector::SegmentedVector<int> g_values;
+    segmented_vector::SegmentedVector<int> f_values;
+    segmented_vector::SegmentedVector<StateID> parents;
+    segmented_vector::SegmentedVector<OperatorID> creating_operators;
+
+    void ensure_capacity(StateID id);
+public:
+    SearchSpace() = default;
+
+    /*
+      Return the status of the state, registering it as NEW if it has not
+      been seen before.
+    */
+    NodeStatus get_status(StateID id) {
+        ensure_capacity(id);
+        return statuses[id.get_value()];
+    }
+
+    int get_g(StateID id) const {
+        return g_values[id.get_value()];
+    }
+
+    /*
+      The search stores the f-value of a state when it evaluates the state,
+      so that it can report progress without evaluating it again.
+    */
+    int get_f(StateID id) const {
+        return f_values[id.get_value()];
+    }
+
+    void set_f(StateID id, int f) {
+        f_values[id.get_value()] = f;
+    }
+
+    StateID get_parent(StateID id) const {
+        return parents[id.get_value()];
+    }
+
+    OperatorID get_creating_operator(StateID id) const {
+        return creating_operators[id.get_value()];
+    }
+
+    void open_initial(StateID id);
+    /*
+      Open (or reopen) the state, reached from parent via op with cost g.
+    */
+    void open(StateID id, int g, StateID parent, OperatorID op);
+    void close(StateID id);
+    void mark_as_dead_end(StateID id);
+
+    /*
+      Follow the parent pointers from goal_id to the initial state and store
+      the operators on the path in plan.
+    */
+    void trace_path(StateID goal_id, Plan &plan) const;
+
+    std::size_t size() const {
+        return statuses.size();
+    }
+
+    std::size_t get_num_bytes() const;
+};
+
+#endif
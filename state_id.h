@@ -1,6 +1,44 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
-class StateID {};
+#include "utils/hash.h"
+
+#include <iosfwd>
+
+/*
+  A StateID is a 32-bit index into the StateRegistry that created it. IDs are
+  handed out consecutively, so they can be used to index per-state data
+  stored in segmented vectors. StateIDs of different registries must not be
+  mixed.
+*/
+class StateID {
+    int value;
+
+public:
+    explicit StateID(int value) : value(value) {
+    }
+
+    static const StateID no_state;
+
+    int get_value() const {
+        return value;
+    }
+
+    bool operator==(const StateID &other) const {
+        return value == other.value;
+    }
+
+    bool operator!=(const StateID &other) const {
+        return !(*this == other);
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, StateID id);
+
+namespace utils {
+inline void feed(HashState &hash_state, StateID id) {
+    feed(hash_state, id.get_value());
+}
+}
 
 #endif
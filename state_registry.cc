@@ -0,0 +1,75 @@
+#include "state_registry.h"
+
+#include <cassert>
+
+using namespace std;
+
+static vector<int> get_domain_sizes(const TaskProxy &task_proxy) {
+    int num_variables = task_proxy.get_num_variables();
+    vector<int> domain_sizes;
+    domain_sizes.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        domain_sizes.push_back(task_proxy.get_variable_domain_size(var));
+    }
+    return domain_sizes;
+}
+
+StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+    : task_proxy(task_proxy),
+      num_variables(task_proxy.get_num_variables()),
+      state_packer(get_domain_sizes(task_proxy)),
+      state_data_pool(state_packer.get_num_bins()),
+      registered_states(
+          StateIDSemanticHash(state_data_pool, state_packer.get_num_bins()),
+          StateIDSemanticEqual(state_data_pool, state_packer.get_num_bins())),
+      packed_buffer(state_packer.get_num_bins()) {
+}
+
+StateID StateRegistry::insert_id_or_pop_state() {
+    /*
+      Attempt to insert a StateID for the last state of state_data_pool
+      if none is present yet. If this fails (another entry for this state
+      is present), we have to remove the duplicate entry from the
+      state data pool.
+    */
+    StateID id(state_data_pool.size() - 1);
+    pair<int, bool> result = registered_states.insert(id.get_value());
+    bool is_new_entry = result.second;
+    if (!is_new_entry) {
+        state_data_pool.pop_back();
+    }
+    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    return StateID(result.first);
+}
+
+StateID StateRegistry::get_initial_state() {
+    return insert_state(task_proxy.get_initial_state_values());
+}
+
+StateID StateRegistry::insert_state(const vector<int> &values) {
+    assert(static_cast<int>(values.size()) == num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(packed_buffer.data(), var, values[var]);
+    }
+    state_data_pool.push_back(packed_buffer.data());
+    return insert_id_or_pop_state();
+}
+
+void StateRegistry::unpack_state(StateID id, vector<int> &values) const {
+    const StateData *data = state_data_pool[id.get_value()];
+    values.resize(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(data, var);
+    }
+}
+
+size_t StateRegistry::get_num_bytes() const {
+    return state_data_pool.get_num_bytes() + registered_states.get_num_bytes();
+}
+
+void StateRegistry::print_statistics(const utils::LogProxy &log) const {
+    log << "Number of registered states: " << size() << '\n';
+    log << "Bytes per state: "
+        << state_packer.get_num_bins() * sizeof(StateData) << '\n';
+    log << "State registry memory: " << get_num_bytes() << " bytes" << '\n';
+}
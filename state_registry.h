@@ -0,0 +1,137 @@
+#ifndef STATE_REGISTRY_H
+#define STATE_REGISTRY_H
+
+#include "state_id.h"
+#include "task_proxy.h"
+
+#include "algorithms/int_hash_set.h"
+#include "algorithms/int_packer.h"
+#include "algorithms/segmented_vector.h"
+#include "utils/hash.h"
+#include "utils/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+  The StateRegistry stores every state that a search encounters exactly once
+  and maps it to a StateID.
+
+  All states are stored bit-packed (see int_packer::IntPacker) in one
+  segmented buffer with a fixed number of bins per state, so a StateID is
+  just the index of a state in that buffer. Duplicate detection uses an open-addressing index over StateIDs
+  whose hash and equality are defined by the stored state data. Looking up a
+  state therefore requires hashing it once and comparing it against at most
+  a few candidates that agree on the stored part of the hash.
+
+  To register a state, we speculatively append it to the buffer and then try
+  to insert its ID into the index. If an equal state already exists, we drop
+  the new copy again.
+*/
+class StateRegistry {
+    using StateData = int_packer::IntPacker::Bin;
+
+    struct StateIDSemanticHash {
+        const segmented_vector::SegmentedArrayVector<StateData>
+            &state_data_pool;
+        int state_size;
+
+        StateIDSemanticHash(
+            const segmented_vector::SegmentedArrayVector<StateData>
+                &state_data_pool,
+            int state_size)
+            : state_data_pool(state_data_pool), state_size(state_size) {
+        }
+
+        std::uint64_t operator()(int id) const {
+            const StateData *data = state_data_pool[id];
+            utils::HashState hash_state;
+            utils::feed(hash_state, data, state_size);
+            return hash_state.get_hash64();
+        }
+    };
+
+    struct StateIDSemanticEqual {
+        const segmented_vector::SegmentedArrayVector<StateData>
+            &state_data_pool;
+        int state_size;
+
+        StateIDSemanticEqual(
+            const segmented_vector::SegmentedArrayVector<StateData>
+                &state_data_pool,
+            int state_size)
+            : state_data_pool(state_data_pool), state_size(state_size) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            const StateData *lhs_data = state_data_pool[lhs];
+            const StateData *rhs_data = state_data_pool[rhs];
+            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+        }
+    };
+
+    using StateIDSet =
+        int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+
+    TaskProxy task_proxy;
+    const int num_variables;
+    const int_packer::IntPacker state_packer;
+    segmented_vector::SegmentedArrayVector<StateData> state_data_pool;
+    StateIDSet registered_states;
+
+    /*
+      Scratch buffer for packing states before they are registered. This
+      makes the registry unsafe to use from multiple threads, which we
+      don't need.
+    */
+    std::vector<StateData> packed_buffer;
+
+    StateID insert_id_or_pop_state();
+public:
+    explicit StateRegistry(const TaskProxy &task_proxy);
+
+    StateRegistry(const StateRegistry &) = delete;
+    StateRegistry &operator=(const StateRegistry &) = delete;
+
+    /*
+      Register the initial state of the task and return its ID. Calling this
+      repeatedly returns the same ID.
+    */
+    StateID get_initial_state();
+
+    /*
+      Register the state with the given values (one per variable) and return
+      its ID. If the state was registered before, the existing ID is
+      returned.
+    */
+    StateID insert_state(const std::vector<int> &values);
+
+    /*
+      Write the values of a registered state into values, which is resized to
+      the number of variables.
+    */
+    void unpack_state(StateID id, std::vector<int> &values) const;
+
+    int get_state_value(StateID id, int var) const {
+        return state_packer.get(state_data_pool[id.get_value()], var);
+    }
+
+    int get_num_variables() const {
+        return num_variables;
+    }
+
+    std::size_t size() const {
+        return registered_states.size();
+    }
+
+    /*
+      Approximate memory used for storing and indexing the registered states.
+    */
+    std::size_t get_num_bytes() const;
+
+    void print_statistics(const utils::LogProxy &log) const;
+};
+
+#endif
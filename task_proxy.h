@@ -1,14 +1,102 @@
 #ifndef TASK_PROXY_H
 #define TASK_PROXY_H
 
+#include <string>
+#include <vector>
+
+struct FactPair {
+    int var;
+    int value;
+
+    FactPair(int var, int value) : var(var), value(value) {
+    }
+};
+
 class AbstractTask {
+public:
+    virtual ~AbstractTask() = default;
+
+    virtual int get_num_variables() const = 0;
+    virtual int get_variable_domain_size(int var) const = 0;
+
+    virtual int get_num_operators() const = 0;
+    virtual std::string get_operator_name(int index) const = 0;
+    virtual int get_operator_cost(int index) const = 0;
+    virtual int get_num_operator_preconditions(int index) const = 0;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index) const = 0;
+    virtual int get_num_operator_effects(int index) const = 0;
+    virtual FactPair get_operator_effect(int op_index, int eff_index) const = 0;
+
+    virtual int get_num_goals() const = 0;
+    virtual FactPair get_goal_fact(int index) const = 0;
+
+    virtual std::vector<int> get_initial_state_values() const = 0;
 };
 
+/*
+  TaskProxy gives components read access to their task. It is cheap to copy
+  and only holds a reference, so the task must outlive it.
+*/
 class TaskProxy {
     const AbstractTask &task;
 public:
     TaskProxy(const AbstractTask &task) : task(task) {
     }
+
+    int get_num_variables() const {
+        return task.get_num_variables();
+    }
+
+    int get_variable_domain_size(int var) const {
+        return task.get_variable_domain_size(var);
+    }
+
+    int get_num_operators() const {
+        return task.get_num_operators();
+    }
+
+    std::string get_operator_name(int index) const {
+        return task.get_operator_name(index);
+    }
+
+    int get_operator_cost(int index) const {
+        return task.get_operator_cost(index);
+    }
+
+    std::vector<FactPair> get_operator_preconditions(int index) const {
+        std::vector<FactPair> preconditions;
+        int num_preconditions = task.get_num_operator_preconditions(index);
+        preconditions.reserve(num_preconditions);
+        for (int i = 0; i < num_preconditions; ++i) {
+            preconditions.push_back(task.get_operator_precondition(index, i));
+        }
+        return preconditions;
+    }
+
+    std::vector<FactPair> get_operator_effects(int index) const {
+        std::vector<FactPair> effects;
+        int num_effects = task.get_num_operator_effects(index);
+        effects.reserve(num_effects);
+        for (int i = 0; i < num_effects; ++i) {
+            effects.push_back(task.get_operator_effect(index, i));
+        }
+        return effects;
+    }
+
+    std::vector<FactPair> get_goals() const {
+        std::vector<FactPair> goals;
+        int num_goals = task.get_num_goals();
+        goals.reserve(num_goals);
+        for (int i = 0; i < num_goals; ++i) {
+            goals.push_back(task.get_goal_fact(i));
+        }
+        return goals;
+    }
+
+    std::vector<int> get_initial_state_values() const {
+        return task.get_initial_state_values();
+    }
 };
 
 #endif
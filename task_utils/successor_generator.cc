@@ -0,0 +1,55 @@
+#include "successor_generator.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace successor_generator {
+SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy) {
+    int num_operators = task_proxy.get_num_operators();
+    precondition_offsets.reserve(num_operators + 1);
+    effect_offsets.reserve(num_operators + 1);
+    costs.reserve(num_operators);
+    for (int op = 0; op < num_operators; ++op) {
+        precondition_offsets.push_back(preconditions.size());
+        for (const FactPair &fact : task_proxy.get_operator_preconditions(op)) {
+            preconditions.push_back(fact);
+        }
+        effect_offsets.push_back(effects.size());
+        for (const FactPair &fact : task_proxy.get_operator_effects(op)) {
+            effects.push_back(fact);
+        }
+        costs.push_back(task_proxy.get_operator_cost(op));
+    }
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
+}
+
+void SuccessorGenerator::generate_applicable_ops(
+    const vector<int> &state_values, vector<OperatorID> &applicable_ops) const {
+    int num_operators = costs.size();
+    for (int op = 0; op < num_operators; ++op) {
+        bool applicable = true;
+        for (int i = precondition_offsets[op];
+             i < precondition_offsets[op + 1]; ++i) {
+            const FactPair &fact = preconditions[i];
+            if (state_values[fact.var] != fact.value) {
+                applicable = false;
+                break;
+            }
+        }
+        if (applicable) {
+            applicable_ops.emplace_back(op);
+        }
+    }
+}
+
+void SuccessorGenerator::apply_operator(
+    OperatorID op, vector<int> &state_values) const {
+    int index = op.get_index();
+    for (int i = effect_offsets[index]; i < effect_offsets[index + 1]; ++i) {
+        const FactPair &fact = effects[i];
+        state_values[fact.var] = fact.value;
+    }
+}
+}
@@ -0,0 +1,42 @@
+#ifndef TASK_UTILS_SUCCESSOR_GENERATOR_H
+#define TASK_UTILS_SUCCESSOR_GENERATOR_H
+
+#include "../operator_id.h"
+#include "../task_proxy.h"
+
+#include <vector>
+
+namespace successor_generator {
+/*
+  Copy of the preconditions, effects and costs of all operators in flat
+  arrays, so that generating successors in the inner loop of a search does
+  not go through the virtual AbstractTask interface. Applicable operators are
+  found by testing every operator in turn.
+*/
+class SuccessorGenerator {
+    std::vector<FactPair> preconditions;
+    std::vector<FactPair> effects;
+    // The facts of operator i are in [offsets[i], offsets[i + 1]).
+    std::vector<int> precondition_offsets;
+    std::vector<int> effect_offsets;
+    std::vector<int> costs;
+public:
+    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+
+    void generate_applicable_ops(
+        const std::vector<int> &state_values,
+        std::vector<OperatorID> &applicable_ops) const;
+
+    /*
+      Apply the effects of op to state_values in place. The operator must be
+      applicable.
+    */
+    void apply_operator(OperatorID op, std::vector<int> &state_values) const;
+
+    int get_operator_cost(OperatorID op) const {
+        return costs[op.get_index()];
+    }
+};
+}
+
+#endif
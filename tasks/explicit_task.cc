@@ -0,0 +1,66 @@
+#include "explicit_task.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace tasks {
+ExplicitTask::ExplicitTask(
+    const vector<int> &domain_sizes, const vector<ExplicitOperator> &operators,
+    const vector<FactPair> &goals, const vector<int> &initial_state_values)
+    : domain_sizes(domain_sizes),
+      operators(operators),
+      goals(goals),
+      initial_state_values(initial_state_values) {
+    assert(initial_state_values.size() == domain_sizes.size());
+}
+
+int ExplicitTask::get_num_variables() const {
+    return domain_sizes.size();
+}
+
+int ExplicitTask::get_variable_domain_size(int var) const {
+    return domain_sizes[var];
+}
+
+int ExplicitTask::get_num_operators() const {
+    return operators.size();
+}
+
+string ExplicitTask::get_operator_name(int index) const {
+    return operators[index].name;
+}
+
+int ExplicitTask::get_operator_cost(int index) const {
+    return operators[index].cost;
+}
+
+int ExplicitTask::get_num_operator_preconditions(int index) const {
+    return operators[index].preconditions.size();
+}
+
+FactPair ExplicitTask::get_operator_precondition(
+    int op_index, int fact_index) const {
+    return operators[op_index].preconditions[fact_index];
+}
+
+int ExplicitTask::get_num_operator_effects(int index) const {
+    return operators[index].effects.size();
+}
+
+FactPair ExplicitTask::get_operator_effect(int op_index, int eff_index) const {
+    return operators[op_index].effects[eff_index];
+}
+
+int ExplicitTask::get_num_goals() const {
+    return goals.size();
+}
+
+FactPair ExplicitTask::get_goal_fact(int index) const {
+    return goals[index];
+}
+
+vector<int> ExplicitTask::get_initial_state_values() const {
+    return initial_state_values;
+}
+}
@@ -0,0 +1,54 @@
+#ifndef TASKS_EXPLICIT_TASK_H
+#define TASKS_EXPLICIT_TASK_H
+
+#include "../task_proxy.h"
+
+#include <string>
+#include <vector>
+
+namespace tasks {
+struct ExplicitOperator {
+    std::string name;
+    int cost;
+    std::vector<FactPair> preconditions;
+    std::vector<FactPair> effects;
+};
+
+/*
+  Task whose variables, operators, initial state and goal are given
+  explicitly as data, e.g. built in code for examples or generated by a
+  task generator.
+*/
+class ExplicitTask : public AbstractTask {
+    std::vector<int> domain_sizes;
+    std::vector<ExplicitOperator> operators;
+    std::vector<FactPair> goals;
+    std::vector<int> initial_state_values;
+public:
+    ExplicitTask(
+        const std::vector<int> &domain_sizes,
+        const std::vector<ExplicitOperator> &operators,
+        const std::vector<FactPair> &goals,
+        const std::vector<int> &initial_state_values);
+
+    virtual int get_num_variables() const override;
+    virtual int get_variable_domain_size(int var) const override;
+
+    virtual int get_num_operators() const override;
+    virtual std::string get_operator_name(int index) const override;
+    virtual int get_operator_cost(int index) const override;
+    virtual int get_num_operator_preconditions(int index) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index) const override;
+    virtual int get_num_operator_effects(int index) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index) const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual std::vector<int> get_initial_state_values() const override;
+};
+}
+
+#endif
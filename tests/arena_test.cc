@@ -0,0 +1,78 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../tasks/explicit_task.h"
+#include "../utils/arena.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// Not task-independent, so it is stored in the cache of each task.
+class NegationEvaluator final : public Evaluator {
+    shared_ptr<Evaluator> eval;
+protected:
+    int compute_value(StateID state_id) override {
+        return -eval->evaluate(state_id);
+    }
+public:
+    NegationEvaluator(
+        const shared_ptr<AbstractTask> &task,
+        const shared_ptr<Evaluator> &eval, const string &description,
+        utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), eval(eval) {
+    }
+
+    void dump() override {
+    }
+};
+
+shared_ptr<AbstractTask> create_empty_task() {
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+}
+
+void test_task_arena_is_released_with_its_cache() {
+    auto const_eval =
+        make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+            tuple(4, "const", utils::Verbosity::SILENT));
+    auto negation = make_shared_component<NegationEvaluator, Evaluator>(
+        tuple(const_eval, "negation", utils::Verbosity::SILENT));
+
+    Cache task_independent_cache;
+    shared_ptr<Evaluator> shared_const;
+    weak_ptr<utils::Arena> first_arena;
+    for (int i = 0; i < 2; ++i) {
+        shared_ptr<AbstractTask> task = create_empty_task();
+        auto arena = make_shared<utils::Arena>();
+        if (i == 0) {
+            first_arena = arena;
+        }
+        Cache cache(nullptr, &task_independent_cache);
+        cache.set_arena(arena);
+        arena.reset();
+        shared_ptr<Evaluator> bound = negation->bind_task(task, cache);
+        CHECK(bound->evaluate(StateID(0)) == -4);
+        shared_ptr<Evaluator> bound_const = const_eval->bind_task(task, cache);
+        if (i == 0) {
+            shared_const = bound_const;
+        } else {
+            // The task-independent component is shared by both tasks...
+            CHECK(bound_const == shared_const);
+        }
+    }
+    // ...but does not keep the arena of the first task alive.
+    CHECK(first_arena.expired());
+    CHECK(shared_const->evaluate(StateID(0)) == 4);
+}
+
+test::Test _test("task_arena_is_released_with_its_cache",
+                 test_task_arena_is_released_with_its_cache);
+}
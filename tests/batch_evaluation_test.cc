@@ -0,0 +1,157 @@
+#include "test.h"
+
+#include "../evaluator.h"
+
+#include "../evaluators/saturating_arithmetic.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../tasks/explicit_task.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+namespace {
+const int INFTY = Evaluator::INFTY;
+
+// Values from a table, indexed by StateID.
+class TableEvaluator final : public Evaluator {
+    vector<int> values;
+protected:
+    int compute_value(StateID state_id) override {
+        return values[state_id.get_value()];
+    }
+public:
+    TableEvaluator(
+        const shared_ptr<AbstractTask> &task, const vector<int> &values)
+        : Evaluator(task, "table", utils::Verbosity::SILENT), values(values) {
+    }
+
+    void dump() override {
+    }
+};
+
+/*
+  Random values with many values close to the saturation limits, where
+  vectorized kernels are most likely to go wrong.
+*/
+vector<int> create_values(mt19937 &rng, size_t num_values) {
+    const vector<int> special_values{
+        0, 1, 2, INFTY / 3, INFTY / 2, INFTY / 2 + 1, INFTY - 2, INFTY - 1,
+        INFTY};
+    vector<int> values;
+    for (size_t i = 0; i < num_values; ++i) {
+        if (rng() % 2) {
+            values.push_back(special_values[rng() % special_values.size()]);
+        } else {
+            values.push_back(rng() % 1000);
+        }
+    }
+    return values;
+}
+
+int saturate(int64_t value) {
+    return static_cast<int>(min<int64_t>(value, INFTY));
+}
+
+int add_reference(int lhs, int rhs) {
+    if (lhs == INFTY || rhs == INFTY) {
+        return INFTY;
+    }
+    return saturate(static_cast<int64_t>(lhs) + rhs);
+}
+
+int scale_reference(int value, int weight) {
+    if (value == INFTY) {
+        return INFTY;
+    }
+    return saturate(static_cast<int64_t>(value) * weight);
+}
+
+const vector<int> weights{0, 1, 2, 3, 1000, INFTY - 1, INFTY};
+
+void test_saturating_kernels_match_reference() {
+    mt19937 rng(1);
+    // Lengths below, at and above multiples of the vector width.
+    for (size_t length = 0; length <= 40; ++length) {
+        vector<int> lhs = create_values(rng, length);
+        vector<int> rhs = create_values(rng, length);
+        vector<int> sums = lhs;
+        saturating_arithmetic::add(sums, rhs);
+        for (size_t i = 0; i < length; ++i) {
+            CHECK(sums[i] == add_reference(lhs[i], rhs[i]));
+        }
+        for (int weight : weights) {
+            vector<int> products = lhs;
+            saturating_arithmetic::scale(products, weight);
+            for (size_t i = 0; i < length; ++i) {
+                CHECK(products[i] == scale_reference(lhs[i], weight));
+            }
+        }
+    }
+}
+
+/*
+  Evaluate all states as one batch, which is longer than the chunks of
+  SumEvaluator, and one by one, and compare with the reference.
+*/
+void check_batch_matches_scalar(
+    Evaluator &eval, const vector<int> &expected) {
+    vector<StateID> state_ids;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        state_ids.push_back(StateID(i));
+    }
+    vector<int> batch_values(expected.size());
+    eval.evaluate(state_ids, batch_values);
+    CHECK(batch_values == expected);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(eval.evaluate(state_ids[i]) == expected[i]);
+    }
+}
+
+void test_batch_evaluation_matches_scalar_evaluation() {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    mt19937 rng(2);
+    const size_t num_states = 600;
+    vector<vector<int>> tables;
+    vector<shared_ptr<Evaluator>> leaves;
+    for (int i = 0; i < 3; ++i) {
+        tables.push_back(create_values(rng, num_states));
+        leaves.push_back(make_shared<TableEvaluator>(task, tables.back()));
+    }
+
+    SumEvaluator sum(task, leaves, "sum", utils::Verbosity::SILENT);
+    vector<int> expected_sums(num_states, 0);
+    for (const vector<int> &table : tables) {
+        for (size_t i = 0; i < num_states; ++i) {
+            expected_sums[i] = add_reference(expected_sums[i], table[i]);
+        }
+    }
+    check_batch_matches_scalar(sum, expected_sums);
+
+    SumEvaluator empty_sum(task, {}, "sum", utils::Verbosity::SILENT);
+    check_batch_matches_scalar(empty_sum, vector<int>(num_states, 0));
+
+    for (int weight : weights) {
+        WeightedEvaluator weighted(
+            task, weight, leaves[0], "weighted", utils::Verbosity::SILENT);
+        vector<int> expected_products;
+        for (int value : tables[0]) {
+            expected_products.push_back(scale_reference(value, weight));
+        }
+        check_batch_matches_scalar(weighted, expected_products);
+    }
+}
+
+test::Test _test_kernels("saturating_kernels_match_reference",
+                         test_saturating_kernels_match_reference);
+test::Test _test_batch("batch_evaluation_matches_scalar_evaluation",
+                       test_batch_evaluation_matches_scalar_evaluation);
+}
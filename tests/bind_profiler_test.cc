@@ -0,0 +1,87 @@
+#include "test.h"
+
+#include "../bind_profiler.h"
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../tasks/explicit_task.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+namespace {
+using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
+
+// Bind c + 2 * c, so that c is constructed once and then found in the cache.
+shared_ptr<Evaluator> bind_sum_with_shared_argument() {
+    EvaluatorComponent c =
+        make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+            tuple(3, "c", utils::Verbosity::SILENT));
+    EvaluatorComponent weighted =
+        make_shared_component<WeightedEvaluator, Evaluator>(
+            tuple(2, c, "w", utils::Verbosity::SILENT));
+    EvaluatorComponent sum = make_shared_component<SumEvaluator, Evaluator>(
+        tuple(vector<EvaluatorComponent>{c, weighted}, "sum",
+              utils::Verbosity::SILENT));
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    return sum->bind_task(task);
+}
+
+#ifdef BIND_PROFILING
+void test_bind_profiler_records_constructions_and_cache_hits() {
+    bind_profiler::reset();
+    CHECK(bind_sum_with_shared_argument()->evaluate(StateID(0)) == 9);
+    CHECK(bind_profiler::get_current_node() == nullptr);
+
+    ostringstream folded;
+    bind_profiler::write_folded_stacks(folded);
+    vector<string> stacks;
+    istringstream lines(folded.str());
+    for (string line; getline(lines, line);) {
+        // Drop the time, which varies between runs.
+        stacks.push_back(line.substr(0, line.rfind(' ')));
+    }
+    CHECK(stacks == vector<string>({
+        "SumEvaluator",
+        "SumEvaluator;const_evaluator::ConstEvaluator",
+        "SumEvaluator;WeightedEvaluator",
+        "SumEvaluator;WeightedEvaluator;"
+        "const_evaluator::ConstEvaluator (cached)"}));
+
+    ostringstream json;
+    bind_profiler::write_json(json);
+    CHECK(json.str().find("\"constructed\": false") != string::npos);
+    bind_profiler::reset();
+    ostringstream empty_json;
+    bind_profiler::write_json(empty_json);
+    CHECK(empty_json.str() == "[]\n");
+}
+
+test::Test _test_profile(
+    "bind_profiler_records_constructions_and_cache_hits",
+    test_bind_profiler_records_constructions_and_cache_hits);
+#else
+// Without BIND_PROFILING, the hooks in bind_task must not cost anything.
+static_assert(is_empty_v<bind_profiler::BindScope>);
+static_assert(is_empty_v<bind_profiler::ParentScope>);
+static_assert(is_trivially_destructible_v<bind_profiler::BindScope>);
+
+void test_bind_profiler_is_compiled_out() {
+    CHECK(bind_sum_with_shared_argument()->evaluate(StateID(0)) == 9);
+    CHECK(bind_profiler::get_current_node() == nullptr);
+}
+
+test::Test _test_disabled("bind_profiler_is_compiled_out",
+                          test_bind_profiler_is_compiled_out);
+#endif
+}
@@ -0,0 +1,286 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../open_list_factory.h"
+#include "../search_algorithm.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../open_lists/tiebreaking_open_list.h"
+#include "../search_algorithms/eager.h"
+#include "../tasks/explicit_task.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+int num_fed_arguments = 0;
+
+// Counts how often components feed it into a structural hash.
+struct CountingArgument {
+    int value;
+
+    bool operator==(const CountingArgument &) const = default;
+};
+
+void feed(utils::HashState &hash_state, const CountingArgument &argument) {
+    ++num_fed_arguments;
+    utils::feed(hash_state, argument.value);
+}
+
+class CountingArgumentEvaluator final : public Evaluator {
+    int value;
+protected:
+    int compute_value(StateID) override {
+        return value;
+    }
+public:
+    CountingArgumentEvaluator(
+        const shared_ptr<AbstractTask> &task, CountingArgument argument,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), value(argument.value) {
+    }
+
+    void dump() override {
+    }
+};
+
+// Takes the same arguments as ConstEvaluator, but is a different type.
+class NegatedConstEvaluator final : public Evaluator {
+    int c;
+protected:
+    int compute_value(StateID) override {
+        return -c;
+    }
+public:
+    static constexpr bool task_independent = true;
+
+    NegatedConstEvaluator(
+        const shared_ptr<AbstractTask> &task, int c,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), c(c) {
+    }
+
+    void dump() override {
+        log << -c << '\n';
+    }
+};
+
+// A task-specific heuristic with many ties.
+class ScrambledEvaluator final : public Evaluator {
+    int multiplier;
+protected:
+    int compute_value(StateID state_id) override {
+        return state_id.get_value() * multiplier % 5;
+    }
+public:
+    ScrambledEvaluator(
+        const shared_ptr<AbstractTask> &task, int multiplier,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), multiplier(multiplier) {
+    }
+
+    void dump() override {
+    }
+};
+
+using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
+using SearchComponent = shared_ptr<TaskIndependentComponent<SearchAlgorithm>>;
+
+EvaluatorComponent create_scrambled() {
+    return make_shared_component<ScrambledEvaluator, Evaluator>(
+        tuple(7919, "h", utils::Verbosity::SILENT));
+}
+
+/*
+  A search in which h and f occur twice, once in the f-evaluator and once
+  in the open list, as separately created but structurally equal
+  components.
+*/
+SearchComponent create_search_with_duplicates() {
+    auto create_f = [] {
+        EvaluatorComponent c =
+            make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+                tuple(1, "c", utils::Verbosity::SILENT));
+        EvaluatorComponent weighted =
+            make_shared_component<WeightedEvaluator, Evaluator>(
+                tuple(2, create_scrambled(), "w", utils::Verbosity::SILENT));
+        return make_shared_component<SumEvaluator, Evaluator>(
+            tuple(vector<EvaluatorComponent>{weighted, c}, "f",
+                  utils::Verbosity::SILENT));
+    };
+    auto open_list =
+        make_shared_component<TieBreakingOpenListFactory, OpenListFactory>(
+            tuple(vector<EvaluatorComponent>{create_f(), create_scrambled()},
+                  false, false, "open", utils::Verbosity::SILENT));
+    return make_shared_component<eager_search::EagerSearch, SearchAlgorithm>(
+        tuple(open_list, create_f(), "eager", utils::Verbosity::SILENT));
+}
+
+/*
+  Counters with values 0, ..., max_value that can be incremented and
+  decremented one step at a time, which all have to reach max_value.
+*/
+shared_ptr<AbstractTask> create_counters_task(
+    int num_counters, int max_value) {
+    vector<tasks::ExplicitOperator> operators;
+    for (int var = 0; var < num_counters; ++var) {
+        for (int value = 0; value < max_value; ++value) {
+            string suffix = to_string(var) + "-" + to_string(value);
+            operators.push_back(
+                {"inc-" + suffix, 1, {{var, value}}, {{var, value + 1}}});
+            operators.push_back(
+                {"dec-" + suffix, 1, {{var, value + 1}}, {{var, value}}});
+        }
+    }
+    vector<FactPair> goals;
+    for (int var = 0; var < num_counters; ++var) {
+        goals.emplace_back(var, max_value);
+    }
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>(num_counters, max_value + 1), operators, goals,
+        vector<int>(num_counters, 0));
+}
+
+struct SearchResult {
+    SearchStatus status;
+    Plan plan;
+
+    bool operator==(const SearchResult &) const = default;
+};
+
+SearchResult run_search(SearchAlgorithm &search) {
+    search.search();
+    return {search.get_status(), search.get_plan()};
+}
+
+void test_interning_does_not_change_bind_results() {
+    shared_ptr<AbstractTask> task = create_counters_task(3, 7);
+    Cache plain_cache;
+    SearchResult plain_result =
+        run_search(*create_search_with_duplicates()->bind_task(
+                       task, plain_cache));
+
+    ComponentInterner interner;
+    Cache interning_cache;
+    interning_cache.set_interner(&interner);
+    SearchResult interned_result =
+        run_search(*create_search_with_duplicates()->bind_task(
+                       task, interning_cache));
+    CHECK(plain_result.status == SOLVED);
+    CHECK(interned_result == plain_result);
+
+    // Only the interning cache binds structurally equal components once.
+    EvaluatorComponent h = create_scrambled();
+    EvaluatorComponent h_copy = create_scrambled();
+    shared_ptr<Evaluator> plain_h = h->bind_task(task, plain_cache);
+    shared_ptr<Evaluator> plain_h_copy = h_copy->bind_task(task, plain_cache);
+    CHECK(plain_h != plain_h_copy);
+    shared_ptr<Evaluator> interned_h = h->bind_task(task, interning_cache);
+    CHECK(h_copy->bind_task(task, interning_cache) == interned_h);
+    for (int i = 0; i < 100; ++i) {
+        int value = plain_h->evaluate(StateID(i));
+        CHECK(plain_h_copy->evaluate(StateID(i)) == value);
+        CHECK(interned_h->evaluate(StateID(i)) == value);
+    }
+}
+
+void test_task_independent_components_are_shared_across_tasks() {
+    shared_ptr<AbstractTask> task = create_counters_task(2, 3);
+    shared_ptr<AbstractTask> other_task = create_counters_task(3, 2);
+    ComponentInterner interner;
+    Cache task_independent_cache;
+    task_independent_cache.set_interner(&interner);
+    Cache cache(nullptr, &task_independent_cache);
+    Cache other_cache(nullptr, &task_independent_cache);
+    cache.set_interner(&interner);
+    other_cache.set_interner(&interner);
+
+    auto create_weighted_const = [] {
+        EvaluatorComponent c =
+            make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+                tuple(3, "c", utils::Verbosity::SILENT));
+        return make_shared_component<WeightedEvaluator, Evaluator>(
+            tuple(2, c, "w", utils::Verbosity::SILENT));
+    };
+    EvaluatorComponent weighted = create_weighted_const();
+    CHECK(weighted->is_task_independent());
+    shared_ptr<Evaluator> bound = weighted->bind_task(task, cache);
+    CHECK(create_weighted_const()->bind_task(other_task, other_cache) ==
+          bound);
+    CHECK(bound->evaluate(StateID(0)) == 6);
+
+    // Components that depend on the task are bound once per task.
+    EvaluatorComponent h = create_scrambled();
+    CHECK(!h->is_task_independent());
+    shared_ptr<Evaluator> bound_h = h->bind_task(task, cache);
+    CHECK(h->bind_task(task, cache) == bound_h);
+    CHECK(create_scrambled()->bind_task(other_task, other_cache) != bound_h);
+}
+
+void test_types_are_part_of_the_structure() {
+    auto const_eval =
+        make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+            tuple(2, "c", utils::Verbosity::SILENT));
+    auto const_eval_copy =
+        make_shared_component<const_evaluator::ConstEvaluator, Evaluator>(
+            tuple(2, "c", utils::Verbosity::SILENT));
+    auto negated_eval =
+        make_shared_component<NegatedConstEvaluator, Evaluator>(
+            tuple(2, "c", utils::Verbosity::SILENT));
+
+    CHECK(const_eval->get_structural_hash() ==
+          const_eval_copy->get_structural_hash());
+    CHECK(const_eval->is_structurally_equal(*const_eval_copy));
+    CHECK(const_eval->get_structural_hash() !=
+          negated_eval->get_structural_hash());
+    CHECK(!const_eval->is_structurally_equal(*negated_eval));
+
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    ComponentInterner interner;
+    Cache cache;
+    cache.set_interner(&interner);
+    shared_ptr<Evaluator> bound_const = const_eval->bind_task(task, cache);
+    CHECK(const_eval_copy->bind_task(task, cache) == bound_const);
+    shared_ptr<Evaluator> bound_negated = negated_eval->bind_task(task, cache);
+    CHECK(bound_negated != bound_const);
+    CHECK(bound_negated->evaluate(StateID(0)) == -2);
+}
+
+void test_structural_hash_is_computed_on_demand() {
+    num_fed_arguments = 0;
+    auto eval = make_shared_component<CountingArgumentEvaluator, Evaluator>(
+        tuple(CountingArgument{3}, "counting", utils::Verbosity::SILENT));
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    // Binding without an interner does not need the hash.
+    Cache cache;
+    CHECK(eval->bind_task(task, cache)->evaluate(StateID(0)) == 3);
+    CHECK(num_fed_arguments == 0);
+
+    uint64_t hash = eval->get_structural_hash();
+    CHECK(num_fed_arguments == 1);
+    CHECK(eval->get_structural_hash() == hash);
+    CHECK(num_fed_arguments == 1);
+}
+
+test::Test _test("types_are_part_of_the_structure",
+                 test_types_are_part_of_the_structure);
+test::Test _test_lazy("structural_hash_is_computed_on_demand",
+                      test_structural_hash_is_computed_on_demand);
+test::Test _test_interning("interning_does_not_change_bind_results",
+                           test_interning_does_not_change_bind_results);
+test::Test _test_shared(
+    "task_independent_components_are_shared_across_tasks",
+    test_task_independent_components_are_shared_across_tasks);
+}
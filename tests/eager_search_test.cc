@@ -0,0 +1,228 @@
+#include "test.h"
+
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/linear_combination_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../open_lists/tiebreaking_open_list.h"
+#include "../search_algorithms/eager.h"
+#include "../tasks/explicit_task.h"
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+/*
+  An inadmissible heuristic with many ties that records the order in which
+  states are evaluated. The search registers states in the order in which
+  it generates them, so equal orders mean equal searches.
+*/
+class ScrambledEvaluator final : public Evaluator {
+protected:
+    int compute_value(StateID state_id) override {
+        evaluation_order.push_back(state_id);
+        return state_id.get_value() * 7919 % 5;
+    }
+public:
+    vector<StateID> evaluation_order;
+
+    explicit ScrambledEvaluator(const shared_ptr<AbstractTask> &task)
+        : Evaluator(task, "scrambled") {
+    }
+
+    void dump() override {
+    }
+};
+
+/*
+  The search only specializes its loop for known types, so wrapping the
+  f-evaluator and the open list forces the generic loop.
+*/
+class ForwardingEvaluator final : public Evaluator {
+    shared_ptr<Evaluator> eval;
+protected:
+    int compute_value(StateID state_id) override {
+        return eval->evaluate(state_id);
+    }
+
+    void compute_values(
+        span<const StateID> state_ids, span<int> values) override {
+        eval->evaluate(state_ids, values);
+    }
+public:
+    ForwardingEvaluator(
+        const shared_ptr<AbstractTask> &task,
+        const shared_ptr<Evaluator> &eval)
+        : Evaluator(task, "forward"), eval(eval) {
+    }
+
+    void get_involved_evaluators(set<Evaluator *> &evals) override {
+        evals.insert(this);
+        eval->get_involved_evaluators(evals);
+    }
+
+    void dump() override {
+    }
+};
+
+class ForwardingOpenList final : public StateOpenList {
+    unique_ptr<StateOpenList> open_list;
+protected:
+    void do_insertion(const StateOpenListEntry &entry) override {
+        open_list->insert(entry);
+    }
+
+    void do_batch_insertion(span<const StateOpenListEntry> entries) override {
+        open_list->insert(entries);
+    }
+public:
+    explicit ForwardingOpenList(unique_ptr<StateOpenList> open_list)
+        : open_list(move(open_list)) {
+    }
+
+    StateOpenListEntry remove_min() override {
+        return open_list->remove_min();
+    }
+
+    bool empty() const override {
+        return open_list->empty();
+    }
+
+    void clear() override {
+        open_list->clear();
+    }
+
+    void get_involved_evaluators(set<Evaluator *> &evals) override {
+        open_list->get_involved_evaluators(evals);
+    }
+
+    void dump() override {
+    }
+};
+
+class ForwardingOpenListFactory final : public OpenListFactory {
+    shared_ptr<OpenListFactory> factory;
+public:
+    ForwardingOpenListFactory(
+        const shared_ptr<AbstractTask> &task,
+        const shared_ptr<OpenListFactory> &factory)
+        : OpenListFactory(task), factory(factory) {
+    }
+
+    unique_ptr<StateOpenList> create_state_open_list() override {
+        return make_unique<ForwardingOpenList>(
+            factory->create_state_open_list());
+    }
+
+    unique_ptr<EdgeOpenList> create_edge_open_list() override {
+        return factory->create_edge_open_list();
+    }
+};
+
+/*
+  Counters with values 0, ..., max_value that can be incremented and
+  decremented one step at a time, which all have to reach max_value.
+*/
+shared_ptr<AbstractTask> create_counters_task(
+    int num_counters, int max_value) {
+    vector<tasks::ExplicitOperator> operators;
+    for (int var = 0; var < num_counters; ++var) {
+        for (int value = 0; value < max_value; ++value) {
+            string suffix = to_string(var) + "-" + to_string(value);
+            operators.push_back(
+                {"inc-" + suffix, 1, {{var, value}}, {{var, value + 1}}});
+            operators.push_back(
+                {"dec-" + suffix, 1, {{var, value + 1}}, {{var, value}}});
+        }
+    }
+    vector<FactPair> goals;
+    for (int var = 0; var < num_counters; ++var) {
+        goals.emplace_back(var, max_value);
+    }
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>(num_counters, max_value + 1), operators, goals,
+        vector<int>(num_counters, 0));
+}
+
+struct SearchResult {
+    SearchStatus status;
+    Plan plan;
+    vector<StateID> evaluation_order;
+};
+
+using FEvaluatorFactory = function<shared_ptr<Evaluator>(
+    const shared_ptr<AbstractTask> &, const shared_ptr<Evaluator> &h)>;
+
+SearchResult run_search(const FEvaluatorFactory &create_f, bool generic) {
+    shared_ptr<AbstractTask> task = create_counters_task(3, 7);
+    auto h = make_shared<ScrambledEvaluator>(task);
+    shared_ptr<Evaluator> f = create_f(task, h);
+    shared_ptr<OpenListFactory> open_list_factory =
+        make_shared<TieBreakingOpenListFactory>(
+            task, vector<shared_ptr<Evaluator>>{f, h}, false, false, "open",
+            utils::Verbosity::SILENT);
+    if (generic) {
+        f = make_shared<ForwardingEvaluator>(task, f);
+        open_list_factory = make_shared<ForwardingOpenListFactory>(
+            task, open_list_factory);
+    }
+    eager_search::EagerSearch search(
+        task, open_list_factory, f, "eager", utils::Verbosity::SILENT);
+    search.search();
+    return {search.get_status(), search.get_plan(), h->evaluation_order};
+}
+
+void check_specialized_matches_generic(const FEvaluatorFactory &create_f) {
+    SearchResult specialized = run_search(create_f, false);
+    SearchResult generic = run_search(create_f, true);
+    CHECK(specialized.status == SOLVED);
+    CHECK(generic.status == SOLVED);
+    CHECK(specialized.plan == generic.plan);
+    CHECK(!specialized.evaluation_order.empty());
+    CHECK(specialized.evaluation_order == generic.evaluation_order);
+}
+
+void test_specialized_eager_search_matches_generic() {
+    const utils::Verbosity silent = utils::Verbosity::SILENT;
+    check_specialized_matches_generic(
+        [silent](const shared_ptr<AbstractTask> &task,
+                 const shared_ptr<Evaluator> &) -> shared_ptr<Evaluator> {
+            return make_shared<const_evaluator::ConstEvaluator>(
+                task, 3, "c", silent);
+        });
+    check_specialized_matches_generic(
+        [silent](const shared_ptr<AbstractTask> &task,
+                 const shared_ptr<Evaluator> &h) -> shared_ptr<Evaluator> {
+            auto c = make_shared<const_evaluator::ConstEvaluator>(
+                task, 2, "c", silent);
+            return make_shared<SumEvaluator>(
+                task, vector<shared_ptr<Evaluator>>{h, c}, "sum", silent);
+        });
+    check_specialized_matches_generic(
+        [silent](const shared_ptr<AbstractTask> &task,
+                 const shared_ptr<Evaluator> &h) -> shared_ptr<Evaluator> {
+            return make_shared<WeightedEvaluator>(task, 3, h, "w", silent);
+        });
+    check_specialized_matches_generic(
+        [silent](const shared_ptr<AbstractTask> &task,
+                 const shared_ptr<Evaluator> &h) -> shared_ptr<Evaluator> {
+            auto c = make_shared<const_evaluator::ConstEvaluator>(
+                task, 1, "c", silent);
+            return make_shared<LinearCombinationEvaluator>(
+                task, 4, vector<int>{2, 3},
+                vector<shared_ptr<Evaluator>>{h, c}, "lin");
+        });
+}
+
+test::Test _test_specialized("specialized_eager_search_matches_generic",
+                             test_specialized_eager_search_matches_generic);
+}
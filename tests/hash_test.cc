@@ -0,0 +1,152 @@
+#include "test.h"
+
+#include "../utils/hash.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using namespace std;
+
+namespace {
+/*
+  A key with only 16 distinct hash values, so that long probe sequences
+  form and erasing shifts many entries back.
+*/
+struct CollidingKey {
+    int value;
+
+    bool operator==(const CollidingKey &other) const {
+        return value == other.value;
+    }
+};
+
+void feed(utils::HashState &hash_state, const CollidingKey &key) {
+    utils::feed(hash_state, key.value % 16);
+}
+
+struct CollidingKeyHash {
+    size_t operator()(const CollidingKey &key) const {
+        return hash<int>()(key.value);
+    }
+};
+
+template<typename Map, typename Reference>
+bool have_same_entries(const Map &map, const Reference &reference) {
+    if (map.size() != reference.size()) {
+        return false;
+    }
+    size_t num_iterated = 0;
+    for (const auto &[key, value] : map) {
+        auto it = reference.find(key);
+        if (it == reference.end() || it->second != value) {
+            return false;
+        }
+        ++num_iterated;
+    }
+    return num_iterated == reference.size();
+}
+
+/*
+  Apply the same random operations to a HashMap and an unordered_map and
+  compare them after each operation. Keys are drawn from a small range, so
+  that most operations hit existing entries and the table grows, shrinks
+  and is rehashed many times.
+*/
+template<typename Key, typename MakeKey, typename Hash = hash<Key>>
+void compare_with_unordered_map(MakeKey make_key, int num_keys, int seed) {
+    utils::HashMap<Key, string> map;
+    unordered_map<Key, string, Hash> reference;
+    mt19937 rng(seed);
+    uniform_int_distribution<int> key_dist(0, num_keys - 1);
+    uniform_int_distribution<int> op_dist(0, 99);
+    for (int step = 0; step < 50000; ++step) {
+        Key key = make_key(key_dist(rng));
+        string value = to_string(step);
+        int op = op_dist(rng);
+        if (op < 30) {
+            auto [it, inserted] = map.emplace(key, value);
+            auto [ref_it, ref_inserted] = reference.emplace(key, value);
+            CHECK(inserted == ref_inserted);
+            CHECK(it->second == ref_it->second);
+        } else if (op < 45) {
+            map[key] = value;
+            reference[key] = value;
+        } else if (op < 65) {
+            CHECK(map.erase(key) == reference.erase(key));
+        } else if (op < 75) {
+            auto it = map.find(key);
+            CHECK((it == map.end()) == !reference.count(key));
+            if (it != map.end()) {
+                map.erase(it);
+                reference.erase(key);
+            }
+        } else if (op < 95) {
+            auto it = map.find(key);
+            auto ref_it = reference.find(key);
+            CHECK((it == map.end()) == (ref_it == reference.end()));
+            if (it != map.end() && ref_it != reference.end()) {
+                CHECK(it->second == ref_it->second);
+            }
+        } else if (op < 97) {
+            map.reserve(map.size() + key_dist(rng));
+        } else if (op < 98) {
+            utils::HashMap<Key, string> copy(map);
+            map = move(copy);
+        } else if (step % 10 == 0) {
+            map.clear();
+            reference.clear();
+        }
+        CHECK(map.size() == reference.size());
+        if (step % 97 == 0) {
+            CHECK(have_same_entries(map, reference));
+        }
+    }
+    CHECK(have_same_entries(map, reference));
+}
+
+void test_hash_map_matches_unordered_map() {
+    compare_with_unordered_map<int>([](int i) {return i;}, 500, 1);
+    compare_with_unordered_map<string>(
+        [](int i) {return "key" + to_string(i);}, 2000, 2);
+}
+
+void test_colliding_keys_match_unordered_map() {
+    compare_with_unordered_map<CollidingKey, CollidingKey (*)(int),
+                               CollidingKeyHash>(
+        [](int i) {return CollidingKey{i};}, 300, 3);
+}
+
+void test_erasing_while_iterating_over_a_copy() {
+    utils::HashSet<int> set;
+    unordered_set<int> reference;
+    for (int i = 0; i < 1000; ++i) {
+        set.insert(i * 7);
+        reference.insert(i * 7);
+    }
+    // Erasing moves entries, so we iterate over a copy.
+    utils::HashSet<int> copy(set);
+    for (int key : copy) {
+        if (key % 3 == 0) {
+            set.erase(key);
+            reference.erase(key);
+        }
+    }
+    CHECK(set.size() == reference.size());
+    size_t num_iterated = 0;
+    for (int key : set) {
+        CHECK(reference.count(key));
+        ++num_iterated;
+    }
+    CHECK(num_iterated == reference.size());
+}
+
+test::Test _test_map("hash_map_matches_unordered_map",
+                     test_hash_map_matches_unordered_map);
+test::Test _test_colliding("colliding_keys_match_unordered_map",
+                           test_colliding_keys_match_unordered_map);
+test::Test _test_set("erasing_while_iterating_over_a_copy",
+                     test_erasing_while_iterating_over_a_copy);
+}
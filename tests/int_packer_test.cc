@@ -0,0 +1,61 @@
+#include "test.h"
+
+#include "../algorithms/int_packer.h"
+#include "../utils/hash.h"
+
+#include <vector>
+
+using namespace std;
+
+namespace {
+using Bin = int_packer::IntPacker::Bin;
+
+void test_int_packer_uses_few_bins() {
+    // The example from the class comment: 80 bits in three bins.
+    vector<int> ranges(40, 2);
+    ranges.insert(ranges.end(), 20, 4);
+    CHECK(int_packer::IntPacker(ranges).get_num_bins() == 3);
+    // 32 binary variables fill one bin exactly.
+    CHECK(int_packer::IntPacker(vector<int>(32, 2)).get_num_bins() == 1);
+    CHECK(int_packer::IntPacker(vector<int>(33, 2)).get_num_bins() == 2);
+    // Variables with a single value still take a bit.
+    CHECK(int_packer::IntPacker(vector<int>(3, 1)).get_num_bins() == 1);
+    // Three 17-bit variables cannot share bins.
+    CHECK(int_packer::IntPacker(vector<int>(3, 1 << 17)).get_num_bins() == 3);
+}
+
+void test_variables_do_not_straddle_bins() {
+    // 11 bits each, so packing without gaps would cross bin boundaries.
+    vector<int> ranges(20, 2000);
+    int_packer::IntPacker packer(ranges);
+    int num_bins = packer.get_num_bins();
+    for (size_t var = 0; var < ranges.size(); ++var) {
+        vector<Bin> buffer(num_bins, 0);
+        packer.set(buffer.data(), var, ranges[var] - 1);
+        int num_used_bins = 0;
+        for (Bin bin : buffer) {
+            num_used_bins += bin != 0;
+        }
+        CHECK(num_used_bins == 1);
+        CHECK(packer.get(buffer.data(), var) == ranges[var] - 1);
+    }
+}
+
+void test_packed_states_are_hashed_without_length() {
+    vector<Bin> buffer{1, 2, 3};
+    utils::HashState array_hash;
+    utils::feed(array_hash, buffer.data(), buffer.size());
+    utils::HashState element_hash;
+    for (Bin bin : buffer) {
+        utils::feed(element_hash, bin);
+    }
+    CHECK(array_hash.get_hash64() == element_hash.get_hash64());
+}
+
+test::Test _test_bins("int_packer_uses_few_bins",
+                      test_int_packer_uses_few_bins);
+test::Test _test_straddle("variables_do_not_straddle_bins",
+                          test_variables_do_not_straddle_bins);
+test::Test _test_hash("packed_states_are_hashed_without_length",
+                      test_packed_states_are_hashed_without_length);
+}
@@ -0,0 +1,125 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../evaluators/saturating_arithmetic.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../evaluators/weighted_evaluator.h"
+#include "../tasks/explicit_task.h"
+
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+namespace {
+using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
+
+// A leaf evaluator that cannot be folded away.
+class FixedValueEvaluator final : public Evaluator {
+    int value;
+protected:
+    int compute_value(StateID) override {
+        return value;
+    }
+public:
+    static constexpr bool task_independent = true;
+
+    FixedValueEvaluator(
+        const shared_ptr<AbstractTask> &task, int value,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), value(value) {
+    }
+
+    void dump() override {
+        log << "fixed " << value << '\n';
+    }
+};
+
+shared_ptr<AbstractTask> create_task() {
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>{2}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{{0, 1}}, vector<int>{0});
+}
+
+EvaluatorComponent create_fixed(int value) {
+    return make_shared_component<FixedValueEvaluator, Evaluator>(
+        tuple(value, "fixed", utils::Verbosity::SILENT));
+}
+
+EvaluatorComponent create_weighted(int weight, const EvaluatorComponent &eval) {
+    return make_shared_component<WeightedEvaluator, Evaluator>(
+        tuple(weight, eval, "weighted", utils::Verbosity::SILENT));
+}
+
+EvaluatorComponent create_sum(const vector<EvaluatorComponent> &evals) {
+    return make_shared_component<SumEvaluator, Evaluator>(
+        tuple(evals, "sum", utils::Verbosity::SILENT));
+}
+
+/*
+  The unfolded value of 0 * (w * e) for a leaf with value e, computed
+  step by step with the saturating semantics.
+*/
+int get_unfolded_value(int inner_weight, int e) {
+    int inner = e;
+    saturating_arithmetic::scale(span<int>(&inner, 1), inner_weight);
+    saturating_arithmetic::scale(span<int>(&inner, 1), 0);
+    return inner;
+}
+
+void test_zero_weight_over_saturating_weight() {
+    shared_ptr<AbstractTask> task = create_task();
+    const int large = (Evaluator::INFTY - 1) / 2 + 1;
+    for (int e : {0, 5, large, Evaluator::INFTY}) {
+        shared_ptr<Evaluator> folded =
+            create_weighted(0, create_weighted(2, create_fixed(e)))
+                ->bind_task(task);
+        CHECK(folded->evaluate(StateID(0)) == get_unfolded_value(2, e));
+    }
+    shared_ptr<Evaluator> saturating =
+        create_weighted(0, create_weighted(2, create_fixed(large)))
+            ->bind_task(task);
+    CHECK(saturating->evaluate(StateID(0)) == Evaluator::INFTY);
+    shared_ptr<Evaluator> small =
+        create_weighted(0, create_weighted(2, create_fixed(5)))
+            ->bind_task(task);
+    CHECK(small->evaluate(StateID(0)) == 0);
+}
+
+void test_zero_weight_over_saturating_sum() {
+    shared_ptr<AbstractTask> task = create_task();
+    const int half = Evaluator::INFTY / 2 + 1;
+    shared_ptr<Evaluator> saturating =
+        create_weighted(0, create_sum({create_fixed(half), create_fixed(half)}))
+            ->bind_task(task);
+    CHECK(saturating->evaluate(StateID(0)) == Evaluator::INFTY);
+    shared_ptr<Evaluator> small =
+        create_weighted(0, create_sum({create_fixed(3), create_fixed(4)}))
+            ->bind_task(task);
+    CHECK(small->evaluate(StateID(0)) == 0);
+}
+
+void test_positive_weights_are_multiplied() {
+    shared_ptr<AbstractTask> task = create_task();
+    EvaluatorComponent leaf = create_fixed(7);
+    shared_ptr<Evaluator> folded =
+        create_weighted(3, create_sum({create_weighted(2, leaf), leaf}))
+            ->bind_task(task);
+    CHECK(folded->evaluate(StateID(0)) == 3 * (2 * 7 + 7));
+    set<Evaluator *> involved;
+    folded->get_involved_evaluators(involved);
+    // The folded combination 9 * leaf and the leaf itself.
+    CHECK(involved.size() == 2);
+}
+
+test::Test _test_weight("zero_weight_over_saturating_weight",
+                        test_zero_weight_over_saturating_weight);
+test::Test _test_sum("zero_weight_over_saturating_sum",
+                     test_zero_weight_over_saturating_sum);
+test::Test _test_multiply("positive_weights_are_multiplied",
+                          test_positive_weights_are_multiplied);
+}
@@ -0,0 +1,73 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../portfolio_runner.h"
+#include "../search_algorithm.h"
+
+#include "../tasks/explicit_task.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// Solves every task immediately, except those with two variables.
+class PickySearch final : public SearchAlgorithm {
+protected:
+    SearchStatus step() override {
+        if (task_proxy.get_num_variables() == 2) {
+            throw runtime_error("two variables");
+        }
+        return SOLVED;
+    }
+public:
+    static constexpr bool task_independent = false;
+
+    PickySearch(
+        const shared_ptr<AbstractTask> &task, const string &,
+        utils::Verbosity)
+        : SearchAlgorithm(task) {
+    }
+
+    void print_statistics() const override {
+    }
+
+    void dump() override {
+    }
+};
+
+shared_ptr<AbstractTask> create_task(int num_variables) {
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>(num_variables, 2), vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>(num_variables, 0));
+}
+
+void test_exceptions_are_reported_as_errors() {
+    auto search = make_shared_component<PickySearch, SearchAlgorithm>(
+        tuple("picky", utils::Verbosity::SILENT));
+    vector<shared_ptr<AbstractTask>> tasks{
+        create_task(1), create_task(2), create_task(3)};
+    vector<portfolio_runner::TaskResult> results(tasks.size());
+    portfolio_runner::PortfolioRunner runner(2, 1 << 20);
+    portfolio_runner::PortfolioStatistics statistics = runner.run(
+        search, tasks,
+        [&](const portfolio_runner::TaskResult &result) {
+            results[result.task_index] = result;
+        });
+    CHECK(statistics.num_tasks == 3);
+    CHECK(statistics.num_solved == 2);
+    CHECK(statistics.num_errors == 1);
+    CHECK(statistics.num_failed == 0);
+    CHECK(results[0].status == SOLVED);
+    CHECK(results[1].status == ERROR);
+    CHECK(results[1].error == "two variables");
+    CHECK(results[2].status == SOLVED);
+    CHECK(results[2].error.empty());
+}
+
+test::Test _test("exceptions_are_reported_as_errors",
+                 test_exceptions_are_reported_as_errors);
+}
@@ -0,0 +1,107 @@
+#include "test.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include "../open_lists/radix_heap_open_list.h"
+#include "../tasks/explicit_task.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// Returns the value that the test assigned to a state before inserting it.
+class AssignedValueEvaluator final : public Evaluator {
+protected:
+    int compute_value(StateID state_id) override {
+        return values[state_id.get_value()];
+    }
+public:
+    vector<int> values;
+
+    explicit AssignedValueEvaluator(const shared_ptr<AbstractTask> &task)
+        : Evaluator(task, "assigned", utils::Verbosity::SILENT) {
+    }
+
+    void dump() override {
+    }
+};
+
+/*
+  Simulate a search with f-values in the millions: remove the minimum and
+  insert a few successors with larger keys. After num_monotone_steps, some
+  successors get smaller keys than the removed one, which switches the open
+  list to its fallback heap. States with equal keys must come out in FIFO
+  order, and dead ends must not come out at all.
+*/
+void check_against_reference(int num_monotone_steps) {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    auto eval = make_shared<AssignedValueEvaluator>(task);
+    RadixHeapOpenListFactory factory(
+        task, eval, false, "radix", utils::Verbosity::SILENT);
+    unique_ptr<StateOpenList> open_list = factory.create_state_open_list();
+    // Maps (key, insertion number) to the state.
+    map<pair<int, int>, int> reference;
+    int num_inserted = 0;
+    auto insert = [&](int value) {
+        int id = eval->values.size();
+        eval->values.push_back(value);
+        open_list->insert(StateID(id));
+        if (value != Evaluator::INFTY) {
+            reference.emplace(make_pair(value, num_inserted++), id);
+        }
+    };
+
+    mt19937 rng(num_monotone_steps);
+    insert(1000000);
+    for (int step = 0; !reference.empty() && step < 20000; ++step) {
+        int id = open_list->remove_min().get_value();
+        CHECK(id == reference.begin()->second);
+        int key = reference.begin()->first.first;
+        reference.erase(reference.begin());
+        int num_successors = uniform_int_distribution<int>(0, 3)(rng);
+        for (int i = 0; i < num_successors; ++i) {
+            int delta = uniform_int_distribution<int>(0, 100000)(rng);
+            if (delta % 10 == 0) {
+                // Many ties with the removed key.
+                delta = 0;
+            }
+            if (step >= num_monotone_steps && delta % 3 == 0) {
+                insert(max(0, key - delta));
+            } else if (delta % 17 == 0) {
+                insert(Evaluator::INFTY);
+            } else {
+                insert(key + delta);
+            }
+        }
+    }
+    while (!reference.empty()) {
+        CHECK(open_list->remove_min().get_value() ==
+              reference.begin()->second);
+        reference.erase(reference.begin());
+    }
+    CHECK(open_list->empty());
+}
+
+void test_radix_heap_orders_monotone_keys() {
+    check_against_reference(numeric_limits<int>::max());
+}
+
+void test_radix_heap_falls_back_for_smaller_keys() {
+    check_against_reference(500);
+}
+
+test::Test _test_monotone("radix_heap_orders_monotone_keys",
+                          test_radix_heap_orders_monotone_keys);
+test::Test _test_fallback("radix_heap_falls_back_for_smaller_keys",
+                          test_radix_heap_falls_back_for_smaller_keys);
+}
@@ -0,0 +1,80 @@
+#include "test.h"
+
+#include "../search_space.h"
+
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+/*
+  One byte of status and four bytes each of g-value, f-value, parent and
+  operator. A node struct with the same members would take 20 bytes.
+*/
+static_assert(sizeof(NodeStatus) == 1);
+static_assert(sizeof(StateID) == 4);
+static_assert(sizeof(OperatorID) == 4);
+static_assert(is_trivially_copyable_v<StateID> &&
+              is_trivially_copyable_v<OperatorID>);
+
+void test_search_space_stores_each_field_densely() {
+    SearchSpace search_space;
+    CHECK(search_space.get_num_bytes() == 0);
+    const size_t num_states = 1 << 16;
+    search_space.get_status(StateID(num_states - 1));
+    CHECK(search_space.size() == num_states);
+    /*
+      Every array fills whole 8 KiB segments, so all that comes on top of
+      17 bytes per state are the segment tables, whose capacity is at most
+      twice the number of segments.
+    */
+    size_t num_segments = 17 * num_states / 8192;
+    size_t num_bytes = search_space.get_num_bytes();
+    CHECK(num_bytes >= 17 * num_states);
+    CHECK(num_bytes <= 17 * num_states + 2 * num_segments * sizeof(void *));
+}
+
+void test_search_space_tracks_nodes() {
+    SearchSpace search_space;
+    StateID init(0);
+    StateID a(1);
+    StateID b(2);
+    StateID dead(5);
+    CHECK(search_space.get_status(dead) == NodeStatus::NEW);
+    // Registering a state registers all states with lower IDs.
+    CHECK(search_space.size() == 6);
+    search_space.set_f(a, 3);
+    CHECK(search_space.get_f(a) == 3);
+
+    search_space.open_initial(init);
+    CHECK(search_space.get_status(init) == NodeStatus::OPEN);
+    CHECK(search_space.get_g(init) == 0);
+    search_space.close(init);
+    search_space.open(a, 4, init, OperatorID(7));
+    search_space.open(b, 9, init, OperatorID(8));
+    search_space.close(a);
+    // Reopen b with a cheaper path through a.
+    search_space.open(b, 5, a, OperatorID(3));
+    CHECK(search_space.get_status(b) == NodeStatus::OPEN);
+    CHECK(search_space.get_g(b) == 5);
+    CHECK(search_space.get_parent(b) == a);
+    CHECK(search_space.get_creating_operator(b) == OperatorID(3));
+    search_space.close(b);
+    CHECK(search_space.get_status(b) == NodeStatus::CLOSED);
+    search_space.mark_as_dead_end(dead);
+    CHECK(search_space.get_status(dead) == NodeStatus::DEAD_END);
+
+    Plan plan;
+    search_space.trace_path(b, plan);
+    CHECK(plan == Plan({OperatorID(7), OperatorID(3)}));
+    Plan empty_plan;
+    search_space.trace_path(init, empty_plan);
+    CHECK(empty_plan.empty());
+}
+
+test::Test _test_dense("search_space_stores_each_field_densely",
+                       test_search_space_stores_each_field_densely);
+test::Test _test_nodes("search_space_tracks_nodes",
+                       test_search_space_tracks_nodes);
+}
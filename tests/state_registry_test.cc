@@ -0,0 +1,84 @@
+#include "test.h"
+
+#include "../state_registry.h"
+
+#include "../algorithms/int_packer.h"
+#include "../tasks/explicit_task.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+/*
+  Domains of very different sizes, so that the packer has to distribute the
+  variables over several bins.
+*/
+const vector<int> DOMAIN_SIZES{2, 3, 1000, 1 << 20, 7, 2, 65536, 5, 1 << 30, 2};
+
+vector<int> create_random_state(mt19937 &rng) {
+    vector<int> values;
+    for (int domain_size : DOMAIN_SIZES) {
+        values.push_back(uniform_int_distribution<int>(0, domain_size - 1)(rng));
+    }
+    return values;
+}
+
+void test_int_packer_round_trip() {
+    int_packer::IntPacker packer(DOMAIN_SIZES);
+    CHECK(packer.get_num_bins() > 1);
+    vector<int_packer::IntPacker::Bin> buffer(packer.get_num_bins(), 0);
+    mt19937 rng(1);
+    for (int i = 0; i < 1000; ++i) {
+        vector<int> values = create_random_state(rng);
+        // Overwrite the variables in a different order than we read them.
+        for (int var = DOMAIN_SIZES.size() - 1; var >= 0; --var) {
+            packer.set(buffer.data(), var, values[var]);
+        }
+        for (size_t var = 0; var < DOMAIN_SIZES.size(); ++var) {
+            CHECK(packer.get(buffer.data(), var) == values[var]);
+        }
+    }
+}
+
+void test_registry_round_trip() {
+    mt19937 rng(2);
+    vector<int> initial_state = create_random_state(rng);
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        DOMAIN_SIZES, vector<tasks::ExplicitOperator>{}, vector<FactPair>{},
+        initial_state);
+    StateRegistry registry{TaskProxy(*task)};
+    StateID initial_id = registry.get_initial_state();
+    CHECK(registry.get_initial_state() == initial_id);
+
+    // Draw states from a small pool, so that many insertions are duplicates.
+    vector<vector<int>> pool{initial_state};
+    for (int i = 0; i < 999; ++i) {
+        pool.push_back(create_random_state(rng));
+    }
+    map<vector<int>, StateID> ids{{initial_state, initial_id}};
+    for (int i = 0; i < 20000; ++i) {
+        const vector<int> &values =
+            pool[uniform_int_distribution<size_t>(0, pool.size() - 1)(rng)];
+        StateID id = registry.insert_state(values);
+        auto [it, inserted] = ids.emplace(values, id);
+        CHECK(it->second == id);
+    }
+    CHECK(registry.size() == ids.size());
+
+    vector<int> unpacked;
+    for (const auto &[values, id] : ids) {
+        registry.unpack_state(id, unpacked);
+        CHECK(unpacked == values);
+        for (size_t var = 0; var < values.size(); ++var) {
+            CHECK(registry.get_state_value(id, var) == values[var]);
+        }
+    }
+}
+
+test::Test _test_packer("int_packer_round_trip", test_int_packer_round_trip);
+test::Test _test_registry("registry_round_trip", test_registry_round_trip);
+}
@@ -0,0 +1,55 @@
+#include "test.h"
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+int num_failures = 0;
+
+vector<pair<string, test::TestFunction>> &get_tests() {
+    static vector<pair<string, test::TestFunction>> tests;
+    return tests;
+}
+}
+
+namespace test {
+Test::Test(const string &name, TestFunction run) {
+    get_tests().emplace_back(name, run);
+}
+
+void report_failure(const char *file, int line, const char *condition) {
+    ++num_failures;
+    utils::g_log << file << ":" << line << ": check failed: " << condition
+                 << '\n';
+}
+}
+
+int main(int argc, char **argv) {
+    vector<string> names(argv + 1, argv + argc);
+    vector<pair<string, test::TestFunction>> &tests = get_tests();
+    sort(tests.begin(), tests.end());
+    int num_tests = 0;
+    int num_failed_tests = 0;
+    for (const auto &[name, run] : tests) {
+        if (!names.empty() &&
+            find(names.begin(), names.end(), name) == names.end()) {
+            continue;
+        }
+        int num_previous_failures = num_failures;
+        run();
+        ++num_tests;
+        bool failed = num_failures > num_previous_failures;
+        num_failed_tests += failed;
+        utils::g_log << (failed ? "FAILED " : "passed ") << name << '\n';
+    }
+    utils::g_log << num_tests << " test(s), " << num_failed_tests
+                 << " failed" << '\n';
+    utils::flush_log();
+    return num_failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+#ifndef TESTS_TEST_H
+#define TESTS_TEST_H
+
+#include <string>
+
+/*
+  Unit tests, built into a separate executable with "make run_tests" and
+  run with "make test".
+
+  Each test is a function that checks its expectations with CHECK and
+  registers itself with a Test object in an anonymous namespace:
+
+    test::Test _test("folding_keeps_dead_ends", run_test);
+
+  run_tests runs all registered tests, or only the ones whose names are
+  given on the command line, and exits with a non-zero status if a check
+  failed.
+*/
+namespace test {
+using TestFunction = void (*)();
+
+class Test {
+public:
+    Test(const std::string &name, TestFunction run);
+};
+
+void report_failure(const char *file, int line, const char *condition);
+}
+
+// Unlike assert, checks are also evaluated in builds with NDEBUG.
+#define CHECK(condition)                                                  \
+    do {                                                                  \
+        if (!(condition)) {                                               \
+            test::report_failure(__FILE__, __LINE__, #condition);         \
+        }                                                                 \
+    } while (false)
+
+#endif
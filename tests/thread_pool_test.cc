@@ -0,0 +1,215 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../tasks/explicit_task.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+const int NUM_WORKERS = 4;
+
+atomic<int> num_leaf_constructions = 0;
+atomic<int> num_inner_constructions = 0;
+atomic<bool> leaf_throws = false;
+
+/*
+  Takes long to construct, so that the threads that bind its parents wait
+  for it while it is under construction.
+*/
+class SlowLeafEvaluator final : public Evaluator {
+    int value;
+protected:
+    int compute_value(StateID) override {
+        return value;
+    }
+public:
+    SlowLeafEvaluator(
+        const shared_ptr<AbstractTask> &task, int value,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), value(value) {
+        ++num_leaf_constructions;
+        this_thread::sleep_for(chrono::milliseconds(50));
+        if (leaf_throws) {
+            throw runtime_error("leaf failed");
+        }
+    }
+
+    void dump() override {
+    }
+};
+
+class MaxEvaluator final : public Evaluator {
+    vector<shared_ptr<Evaluator>> evals;
+protected:
+    int compute_value(StateID state_id) override {
+        int result = 0;
+        for (const shared_ptr<Evaluator> &eval : evals) {
+            result = max(result, eval->evaluate(state_id));
+        }
+        return result;
+    }
+public:
+    MaxEvaluator(
+        const shared_ptr<AbstractTask> &task,
+        const vector<shared_ptr<Evaluator>> &evals,
+        const string &description, utils::Verbosity verbosity)
+        : Evaluator(task, description, verbosity), evals(evals) {
+        ++num_inner_constructions;
+    }
+
+    void dump() override {
+    }
+};
+
+using EvaluatorComponent = shared_ptr<TaskIndependentComponent<Evaluator>>;
+
+/*
+  A diamond with many paths: the root uses NUM_WORKERS * 2 inner evaluators,
+  all of which use the same leaf.
+*/
+EvaluatorComponent create_diamond() {
+    EvaluatorComponent leaf =
+        make_shared_component<SlowLeafEvaluator, Evaluator>(
+            tuple(3, "leaf", utils::Verbosity::SILENT));
+    vector<EvaluatorComponent> inner;
+    for (int i = 0; i < 2 * NUM_WORKERS; ++i) {
+        inner.push_back(make_shared_component<MaxEvaluator, Evaluator>(
+            tuple(vector<EvaluatorComponent>{leaf}, "inner",
+                  utils::Verbosity::SILENT)));
+    }
+    return make_shared_component<MaxEvaluator, Evaluator>(
+        tuple(inner, "root", utils::Verbosity::SILENT));
+}
+
+shared_ptr<AbstractTask> create_empty_task() {
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+}
+
+void test_parallel_for_runs_each_iteration_once() {
+    utils::ThreadPool pool(NUM_WORKERS);
+    vector<atomic<int>> num_calls(1000);
+    pool.parallel_for(num_calls.size(), [&](size_t i) {
+        // Nested loops must not deadlock, even with all workers busy.
+        pool.parallel_for(3, [&](size_t) {
+            ++num_calls[i];
+        });
+    });
+    for (const atomic<int> &calls : num_calls) {
+        CHECK(calls == 3);
+    }
+}
+
+void test_parallel_for_rethrows_after_all_calls() {
+    utils::ThreadPool pool(NUM_WORKERS);
+    atomic<int> num_finished = 0;
+    bool caught = false;
+    try {
+        pool.parallel_for(100, [&](size_t i) {
+            if (i == 0) {
+                throw runtime_error("first");
+            }
+            this_thread::sleep_for(chrono::microseconds(100));
+            ++num_finished;
+        });
+    } catch (const runtime_error &e) {
+        caught = string(e.what()) == "first";
+    }
+    CHECK(caught);
+    CHECK(num_finished == 99);
+}
+
+void test_shared_components_are_constructed_once() {
+    num_leaf_constructions = 0;
+    num_inner_constructions = 0;
+    leaf_throws = false;
+    EvaluatorComponent root = create_diamond();
+    shared_ptr<AbstractTask> task = create_empty_task();
+    utils::ThreadPool pool(NUM_WORKERS);
+    Cache cache(&pool);
+    shared_ptr<Evaluator> bound_root = root->bind_task(task, cache);
+    CHECK(num_leaf_constructions == 1);
+    CHECK(num_inner_constructions == 2 * NUM_WORKERS + 1);
+    CHECK(bound_root->evaluate(StateID(0)) == 3);
+}
+
+void test_construction_errors_reach_all_waiting_parents() {
+    num_leaf_constructions = 0;
+    num_inner_constructions = 0;
+    leaf_throws = true;
+    EvaluatorComponent root = create_diamond();
+    shared_ptr<AbstractTask> task = create_empty_task();
+    utils::ThreadPool pool(NUM_WORKERS);
+    Cache cache(&pool);
+    bool caught = false;
+    try {
+        root->bind_task(task, cache);
+    } catch (const runtime_error &e) {
+        caught = string(e.what()) == "leaf failed";
+    }
+    leaf_throws = false;
+    CHECK(caught);
+    CHECK(num_leaf_constructions == 1);
+    CHECK(num_inner_constructions == 0);
+}
+
+void test_cache_passes_exceptions_to_all_waiting_threads() {
+    const int num_threads = 8;
+    Cache cache;
+    int dummy_component;
+    CacheKey key(
+        reinterpret_cast<const TaskIndependentComponentBase *>(&dummy_component),
+        nullptr);
+    atomic<int> num_creations = 0;
+    atomic<int> num_ready = 0;
+    atomic<int> num_exceptions = 0;
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&] {
+            // Start all threads at the same time.
+            ++num_ready;
+            while (num_ready < num_threads) {
+                this_thread::yield();
+            }
+            try {
+                cache.get_or_create<int>(key, [&]() -> shared_ptr<int> {
+                    ++num_creations;
+                    this_thread::sleep_for(chrono::milliseconds(50));
+                    throw runtime_error("creation failed");
+                });
+            } catch (const runtime_error &) {
+                ++num_exceptions;
+            }
+        });
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    CHECK(num_creations == 1);
+    CHECK(num_exceptions == num_threads);
+}
+
+test::Test _test_iterations("parallel_for_runs_each_iteration_once",
+                            test_parallel_for_runs_each_iteration_once);
+test::Test _test_rethrow("parallel_for_rethrows_after_all_calls",
+                         test_parallel_for_rethrows_after_all_calls);
+test::Test _test_once("shared_components_are_constructed_once",
+                      test_shared_components_are_constructed_once);
+test::Test _test_errors("construction_errors_reach_all_waiting_parents",
+                        test_construction_errors_reach_all_waiting_parents);
+test::Test _test_cache("cache_passes_exceptions_to_all_waiting_threads",
+                       test_cache_passes_exceptions_to_all_waiting_threads);
+}
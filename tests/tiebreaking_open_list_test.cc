@@ -0,0 +1,117 @@
+#include "test.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include "../open_lists/tiebreaking_open_list.h"
+#include "../tasks/explicit_task.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+const int NUM_STATES = 5000;
+
+// Looks up the value of each state in a table.
+class TableEvaluator final : public Evaluator {
+    vector<int> values;
+protected:
+    int compute_value(StateID state_id) override {
+        return values[state_id.get_value()];
+    }
+public:
+    TableEvaluator(
+        const shared_ptr<AbstractTask> &task, const vector<int> &values)
+        : Evaluator(task, "table", utils::Verbosity::SILENT), values(values) {
+    }
+
+    void dump() override {
+    }
+};
+
+shared_ptr<AbstractTask> create_empty_task() {
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+}
+
+// Few distinct values, so that there are many ties, and some dead ends.
+vector<int> create_random_values(mt19937 &rng) {
+    vector<int> values;
+    for (int i = 0; i < NUM_STATES; ++i) {
+        int value = uniform_int_distribution<int>(0, 20)(rng);
+        values.push_back(value == 20 ? Evaluator::INFTY : value);
+    }
+    return values;
+}
+
+/*
+  Insert all states in order of their IDs, one by one and in batches of
+  random sizes, and check that they come out ordered by their keys, with
+  ties in insertion order.
+*/
+void check_order(bool unsafe_pruning) {
+    mt19937 rng(unsafe_pruning ? 1 : 2);
+    shared_ptr<AbstractTask> task = create_empty_task();
+    vector<vector<int>> values{
+        create_random_values(rng), create_random_values(rng)};
+    TieBreakingOpenList<StateOpenListEntry> open_list(
+        {make_shared<TableEvaluator>(task, values[0]),
+         make_shared<TableEvaluator>(task, values[1])},
+        unsafe_pruning, false, utils::LogProxy(utils::Verbosity::SILENT));
+
+    vector<StateID> batch;
+    for (int id = 0; id < NUM_STATES;) {
+        int batch_size = min(
+            uniform_int_distribution<int>(1, 8)(rng), NUM_STATES - id);
+        if (batch_size == 1) {
+            open_list.insert(StateID(id++));
+            continue;
+        }
+        batch.clear();
+        for (int i = 0; i < batch_size; ++i) {
+            batch.push_back(StateID(id++));
+        }
+        open_list.insert(span<const StateID>(batch));
+    }
+
+    vector<int> expected;
+    for (int id = 0; id < NUM_STATES; ++id) {
+        bool first_infinite = values[0][id] == Evaluator::INFTY;
+        bool all_infinite =
+            first_infinite && values[1][id] == Evaluator::INFTY;
+        if (!all_infinite && !(unsafe_pruning && first_infinite)) {
+            expected.push_back(id);
+        }
+    }
+    stable_sort(expected.begin(), expected.end(), [&](int lhs, int rhs) {
+                    return make_pair(values[0][lhs], values[1][lhs]) <
+                           make_pair(values[0][rhs], values[1][rhs]);
+                });
+
+    vector<int> removed;
+    while (!open_list.empty()) {
+        removed.push_back(open_list.remove_min().get_value());
+    }
+    CHECK(removed == expected);
+}
+
+void test_tiebreaking_open_list_orders_lexicographically() {
+    check_order(false);
+}
+
+void test_unsafe_pruning_drops_first_infinite_value() {
+    check_order(true);
+}
+
+test::Test _test_order("tiebreaking_open_list_orders_lexicographically",
+                       test_tiebreaking_open_list_orders_lexicographically);
+test::Test _test_pruning("unsafe_pruning_drops_first_infinite_value",
+                         test_unsafe_pruning_drops_first_infinite_value);
+}
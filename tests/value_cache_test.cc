@@ -0,0 +1,155 @@
+#include "test.h"
+
+#include "../component.h"
+#include "../evaluator.h"
+
+#include "../evaluators/const_evaluator.h"
+#include "../evaluators/sum_evaluator.h"
+#include "../open_lists/tiebreaking_open_list.h"
+#include "../search_algorithms/eager.h"
+#include "../tasks/explicit_task.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// A heuristic with many ties that counts how often it is computed.
+class CountingEvaluator final : public Evaluator {
+protected:
+    int compute_value(StateID state_id) override {
+        ++num_computations;
+        return state_id.get_value() * 7919 % 5;
+    }
+public:
+    int num_computations = 0;
+
+    CountingEvaluator(
+        const shared_ptr<AbstractTask> &task, const string &description)
+        : Evaluator(task, description) {
+    }
+
+    void dump() override {
+    }
+};
+
+void test_value_cache_counts_hits_and_misses() {
+    shared_ptr<AbstractTask> task = make_shared<tasks::ExplicitTask>(
+        vector<int>{}, vector<tasks::ExplicitOperator>{},
+        vector<FactPair>{}, vector<int>{});
+    auto component = make_shared_component<CountingEvaluator, Evaluator>(
+        tuple("h"));
+    Cache cache;
+    shared_ptr<Evaluator> h = component->bind_task(task, cache);
+    // Binding again with the same Cache gives the same evaluator.
+    CHECK(component->bind_task(task, cache) == h);
+    auto &counting = dynamic_cast<CountingEvaluator &>(*h);
+    h->enable_value_cache();
+
+    vector<StateID> batch{StateID(0), StateID(1), StateID(2)};
+    vector<int> values(batch.size());
+    h->evaluate(batch, values);
+    CHECK(counting.num_computations == 3);
+    CHECK(h->get_cache_misses() == 3);
+    CHECK(h->get_cache_hits() == 0);
+
+    // A batch with cached and uncached states only computes the latter.
+    vector<StateID> mixed{StateID(3), StateID(1), StateID(4), StateID(0)};
+    vector<int> mixed_values(mixed.size());
+    h->evaluate(mixed, mixed_values);
+    CHECK(counting.num_computations == 5);
+    CHECK(mixed_values[1] == values[1] && mixed_values[3] == values[0]);
+    CHECK(h->evaluate(StateID(2)) == values[2]);
+    CHECK(counting.num_computations == 5);
+    CHECK(h->get_cache_hits() == 3);
+    CHECK(h->get_cache_misses() == 5);
+
+    h->evict_cached_value(StateID(2));
+    CHECK(h->evaluate(StateID(2)) == values[2]);
+    CHECK(counting.num_computations == 6);
+    CHECK(h->get_cache_misses() == 6);
+
+    h->clear_value_cache();
+    CHECK(h->get_cache_hits() == 0);
+    CHECK(h->get_cache_misses() == 0);
+    h->evaluate(StateID(0));
+    CHECK(counting.num_computations == 7);
+}
+
+/*
+  Counters with values 0, ..., max_value that can be incremented and
+  decremented one step at a time, which all have to reach max_value. With
+  unit costs and the heuristic above, some closed states are reopened.
+*/
+shared_ptr<AbstractTask> create_counters_task(
+    int num_counters, int max_value) {
+    vector<tasks::ExplicitOperator> operators;
+    for (int var = 0; var < num_counters; ++var) {
+        for (int value = 0; value < max_value; ++value) {
+            string suffix = to_string(var) + "-" + to_string(value);
+            operators.push_back(
+                {"inc-" + suffix, 1, {{var, value}}, {{var, value + 1}}});
+            operators.push_back(
+                {"dec-" + suffix, 1, {{var, value + 1}}, {{var, value}}});
+        }
+    }
+    vector<FactPair> goals;
+    for (int var = 0; var < num_counters; ++var) {
+        goals.emplace_back(var, max_value);
+    }
+    return make_shared<tasks::ExplicitTask>(
+        vector<int>(num_counters, max_value + 1), operators, goals,
+        vector<int>(num_counters, 0));
+}
+
+/*
+  Run a search in which h is evaluated by the f-evaluator and as the second
+  key of the open list. Return the plan and how often h is computed.
+*/
+pair<Plan, int> run_search_with_shared_heuristic(bool use_cache) {
+    shared_ptr<AbstractTask> task = create_counters_task(3, 7);
+    auto h = make_shared<CountingEvaluator>(task, "h");
+    if (use_cache) {
+        h->enable_value_cache();
+    }
+    auto c = make_shared<const_evaluator::ConstEvaluator>(
+        task, 1, "c", utils::Verbosity::SILENT);
+    auto f = make_shared<SumEvaluator>(
+        task, vector<shared_ptr<Evaluator>>{h, c}, "f",
+        utils::Verbosity::SILENT);
+    auto open_list_factory = make_shared<TieBreakingOpenListFactory>(
+        task, vector<shared_ptr<Evaluator>>{f, h}, false, false, "open",
+        utils::Verbosity::SILENT);
+    eager_search::EagerSearch search(
+        task, open_list_factory, f, "eager", utils::Verbosity::SILENT);
+    search.search();
+    CHECK(search.get_status() == SOLVED);
+    if (use_cache) {
+        CHECK(h->get_cache_misses() == h->num_computations);
+        CHECK(h->get_cache_hits() >= h->num_computations);
+    }
+    return {search.get_plan(), h->num_computations};
+}
+
+void test_value_cache_does_not_change_search() {
+    auto [plan_without_cache, computations_without_cache] =
+        run_search_with_shared_heuristic(false);
+    auto [plan_with_cache, computations_with_cache] =
+        run_search_with_shared_heuristic(true);
+    CHECK(plan_with_cache == plan_without_cache);
+    /*
+      Without the cache, h is computed for the f-value of each new state
+      and twice for each insertion into the open list. With the cache, it
+      is computed at most once per insertion.
+    */
+    CHECK(2 * computations_with_cache <= computations_without_cache);
+}
+
+test::Test _test_hits("value_cache_counts_hits_and_misses",
+                      test_value_cache_counts_hits_and_misses);
+test::Test _test_search("value_cache_does_not_change_search",
+                        test_value_cache_does_not_change_search);
+}
@@ -0,0 +1,14 @@
+#include "arena.h"
+
+using namespace std;
+
+namespace utils {
+Arena::Arena(size_t initial_block_size)
+    : resource(initial_block_size) {
+}
+
+void *Arena::allocate(size_t num_bytes, size_t alignment) {
+    lock_guard<std::mutex> lock(mutex);
+    return resource.allocate(num_bytes, alignment);
+}
+}
@@ -0,0 +1,67 @@
+#ifndef UTILS_ARENA_H
+#define UTILS_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+
+namespace utils {
+/*
+  Thread-safe bump allocator. Memory is handed out from large blocks and
+  only released when the arena is destroyed, all at once. This places
+  objects that are allocated together next to each other in memory and
+  makes releasing them cheap, at the price of never reusing memory of
+  individual objects.
+*/
+class Arena {
+    std::mutex mutex;
+    std::pmr::monotonic_buffer_resource resource;
+public:
+    explicit Arena(std::size_t initial_block_size = 64 * 1024);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(std::size_t num_bytes, std::size_t alignment);
+};
+
+/*
+  Allocator for allocating objects in an Arena. Every copy of the allocator
+  shares ownership of the arena. Objects created with std::allocate_shared
+  store a copy in their control block, so the arena lives until the last of
+  them is destroyed.
+*/
+template<typename T>
+class ArenaAllocator {
+    template<typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<Arena> arena;
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+        : arena(std::move(arena)) {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {
+    }
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t) {
+        // Memory is released with the arena.
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+};
+}
+
+#endif
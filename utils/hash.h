@@ -1,11 +1,16 @@
 #ifndef HASH_H
 #define HASH_H
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
-#include <unordered_set>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -226,6 +231,27 @@ inline void feed(HashState &hash_state, std::uint64_t value) {
     hash_state.feed(static_cast<std::uint32_t>(value));
 }
 
+template<typename T>
+    requires std::is_enum_v<T>
+void feed(HashState &hash_state, T value) {
+    feed(hash_state, static_cast<std::uint64_t>(value));
+}
+
+/*
+  C strings are fed by content (including the terminating zero, which makes
+  this a prefix code), unlike other pointers, which are fed by address.
+*/
+inline void feed(HashState &hash_state, const char *str) {
+    for (const char *c = str; *c; ++c) {
+        hash_state.feed(static_cast<std::uint32_t>(*c));
+    }
+    hash_state.feed(0);
+}
+
+inline void feed(HashState &hash_state, const std::string &str) {
+    feed(hash_state, str.c_str());
+}
+
 template<typename T>
 void feed(HashState &hash_state, const T *p) {
     // This is wasteful in 32-bit mode, but we plan to discontinue 32-bit
@@ -233,6 +259,19 @@ void feed(HashState &hash_state, const T *p) {
     feed(hash_state, reinterpret_cast<std::uint64_t>(p));
 }
 
+/*
+  Feed the elements of an array of known length, e.g. a packed state. As
+  discussed above, we do not feed the length: arrays of different lengths
+  are different logical types and must not be mixed in one container. Use
+  std::vector if the prefix code property is needed.
+*/
+template<typename T>
+void feed(HashState &hash_state, const T *data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        feed(hash_state, data[i]);
+    }
+}
+
 template<typename T1, typename T2>
 void feed(HashState &hash_state, const std::pair<T1, T2> &p) {
     feed(hash_state, p.first);
@@ -286,7 +325,7 @@ std::size_t get_hash(const T &value) {
     return static_cast<std::size_t>(get_hash64(value));
 }
 
-// This struct should only be used by HashMap and HashSet below.
+// This struct should only be used by the hash tables below.
 template<typename T>
 struct Hash {
     std::size_t operator()(const T &val) const {
@@ -295,18 +334,470 @@ struct Hash {
 };
 
 /*
-  Aliases for hash sets and hash maps in user code.
+  Open-addressing hash table underlying HashMap and HashSet below. Do not use
+  it directly.
+
+  All entries are stored in one flat array, so a lookup touches a few
+  adjacent slots instead of chasing pointers through per-entry nodes. We use
+  Robin Hood probing: an entry that is further away from its home slot
+  displaces entries that are closer to theirs. This keeps probe sequences
+  short even at high load factors and lets unsuccessful lookups stop as soon
+  as they reach an entry that is closer to its home slot than the key would
+  be. Erasing shifts the following entries of the probe sequence back by one
+  slot, so we never need tombstones.
+
+  Next to each entry we store its distance from the home slot and the upper
+  32 bits of its hash value. Comparing stored hashes rejects almost all
+  non-matching entries without comparing keys. The home slot is taken from
+  the highest bits of the stored hash, so growing the table never needs to
+  hash a key again.
+*/
+template<typename Key, typename Entry, typename GetKey>
+class OpenAddressingHashTable {
+    struct Slot {
+        // Distance from the home slot plus one; 0 marks an empty slot.
+        std::uint32_t distance;
+        std::uint32_t hash;
+    };
+
+    static constexpr int min_num_bits = 3;
+
+    std::vector<Slot> slots;
+    Entry *entries;
+    std::size_t num_entries;
+    int num_bits;
+
+    static std::uint32_t compute_hash(const Key &key) {
+        return static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(Hash<Key>()(key)) >> 32);
+    }
+
+    static const Key &get_key(const Entry &entry) {
+        return GetKey()(entry);
+    }
+
+    std::size_t get_home(std::uint32_t hash) const {
+        assert(num_bits > 0);
+        return hash >> (32 - num_bits);
+    }
+
+    std::size_t get_mask() const {
+        return slots.size() - 1;
+    }
+
+    bool is_too_full(std::size_t num) const {
+        // Maximum load factor is 4/5.
+        return 5 * num > 4 * slots.size();
+    }
+
+    static Entry *allocate(std::size_t capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        return std::allocator<Entry>().allocate(capacity);
+    }
+
+    void deallocate() {
+        if (entries) {
+            std::allocator<Entry>().deallocate(entries, slots.size());
+            entries = nullptr;
+        }
+    }
+
+    void destroy_entries() {
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].distance) {
+                std::destroy_at(&entries[i]);
+                slots[i].distance = 0;
+            }
+        }
+        num_entries = 0;
+    }
+
+    std::size_t find_index(const Key &key, std::uint32_t hash) const {
+        if (num_entries == 0) {
+            return slots.size();
+        }
+        std::size_t mask = get_mask();
+        std::size_t index = get_home(hash);
+        for (std::uint32_t distance = 1;; ++distance) {
+            const Slot &slot = slots[index];
+            if (slot.distance < distance) {
+                // Also covers empty slots.
+                return slots.size();
+            }
+            if (slot.hash == hash && get_key(entries[index]) == key) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    /*
+      Place an entry that is known not to be in the table yet, displacing
+      entries that are closer to their home slots. Return the slot of the
+      placed entry. The table must have room for it.
+    */
+    std::size_t place(Entry &&entry, std::uint32_t hash) {
+        std::size_t mask = get_mask();
+        std::size_t index = get_home(hash);
+        std::size_t result = slots.size();
+        std::uint32_t distance = 1;
+        while (true) {
+            Slot &slot = slots[index];
+            if (slot.distance == 0) {
+                std::construct_at(&entries[index], std::move(entry));
+                slot.distance = distance;
+                slot.hash = hash;
+                return result == slots.size() ? index : result;
+            }
+            if (slot.distance < distance) {
+                std::swap(entries[index], entry);
+                std::swap(slot.distance, distance);
+                std::swap(slot.hash, hash);
+                if (result == slots.size()) {
+                    result = index;
+                }
+            }
+            index = (index + 1) & mask;
+            ++distance;
+        }
+    }
+
+    void rehash(int new_num_bits) {
+        std::vector<Slot> old_slots(
+            static_cast<std::size_t>(1) << new_num_bits, Slot{0, 0});
+        old_slots.swap(slots);
+        Entry *old_entries = entries;
+        entries = allocate(slots.size());
+        num_bits = new_num_bits;
+        for (std::size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_slots[i].distance) {
+                place(std::move(old_entries[i]), old_slots[i].hash);
+                std::destroy_at(&old_entries[i]);
+            }
+        }
+        if (old_entries) {
+            std::allocator<Entry>().deallocate(old_entries, old_slots.size());
+        }
+    }
+
+    void reserve_for_insertion() {
+        if (slots.empty()) {
+            rehash(min_num_bits);
+        } else if (is_too_full(num_entries + 1)) {
+            rehash(num_bits + 1);
+        }
+    }
+
+    void erase_at(std::size_t index) {
+        std::size_t mask = get_mask();
+        std::destroy_at(&entries[index]);
+        std::size_t next = (index + 1) & mask;
+        while (slots[next].distance > 1) {
+            std::construct_at(&entries[index], std::move(entries[next]));
+            std::destroy_at(&entries[next]);
+            slots[index].distance = slots[next].distance - 1;
+            slots[index].hash = slots[next].hash;
+            index = next;
+            next = (next + 1) & mask;
+        }
+        slots[index].distance = 0;
+        --num_entries;
+    }
+
+public:
+    template<bool IsConst>
+    class Iterator {
+        friend class OpenAddressingHashTable;
+        using Table = std::conditional_t<
+            IsConst, const OpenAddressingHashTable, OpenAddressingHashTable>;
+
+        Table *table;
+        std::size_t index;
+
+        Iterator(Table *table, std::size_t index)
+            : table(table), index(index) {
+        }
+
+        void skip_empty_slots() {
+            while (index < table->slots.size() &&
+                   !table->slots[index].distance) {
+                ++index;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Entry *, Entry *>;
+        using reference = std::conditional_t<IsConst, const Entry &, Entry &>;
+
+        operator Iterator<true>() const {
+            return Iterator<true>(table, index);
+        }
+
+        reference operator*() const {
+            return table->entries[index];
+        }
+
+        pointer operator->() const {
+            return &table->entries[index];
+        }
+
+        Iterator &operator++() {
+            ++index;
+            skip_empty_slots();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    OpenAddressingHashTable()
+        : entries(nullptr), num_entries(0), num_bits(0) {
+    }
+
+    OpenAddressingHashTable(const OpenAddressingHashTable &other)
+        : slots(other.slots),
+          entries(allocate(other.slots.size())),
+          num_entries(other.num_entries),
+          num_bits(other.num_bits) {
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].distance) {
+                std::construct_at(&entries[i], other.entries[i]);
+            }
+        }
+    }
+
+    OpenAddressingHashTable(OpenAddressingHashTable &&other) noexcept
+        : slots(std::move(other.slots)),
+          entries(std::exchange(other.entries, nullptr)),
+          num_entries(std::exchange(other.num_entries, 0)),
+          num_bits(std::exchange(other.num_bits, 0)) {
+        other.slots.clear();
+    }
+
+    OpenAddressingHashTable &operator=(OpenAddressingHashTable other) {
+        swap(other);
+        return *this;
+    }
+
+    ~OpenAddressingHashTable() {
+        destroy_entries();
+        deallocate();
+    }
+
+    void swap(OpenAddressingHashTable &other) noexcept {
+        slots.swap(other.slots);
+        std::swap(entries, other.entries);
+        std::swap(num_entries, other.num_entries);
+        std::swap(num_bits, other.num_bits);
+    }
+
+    iterator begin() {
+        iterator it(this, 0);
+        it.skip_empty_slots();
+        return it;
+    }
+
+    iterator end() {
+        return iterator(this, slots.size());
+    }
+
+    const_iterator begin() const {
+        const_iterator it(this, 0);
+        it.skip_empty_slots();
+        return it;
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, slots.size());
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    bool empty() const {
+        return num_entries == 0;
+    }
+
+    void clear() {
+        destroy_entries();
+    }
+
+    void reserve(std::size_t num) {
+        int new_num_bits = std::max(num_bits, min_num_bits);
+        while (5 * num > 4 * (static_cast<std::size_t>(1) << new_num_bits)) {
+            ++new_num_bits;
+        }
+        if (new_num_bits != num_bits) {
+            rehash(new_num_bits);
+        }
+    }
+
+    iterator find(const Key &key) {
+        return iterator(this, find_index(key, compute_hash(key)));
+    }
+
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, find_index(key, compute_hash(key)));
+    }
+
+    std::size_t count(const Key &key) const {
+        return find_index(key, compute_hash(key)) != slots.size();
+    }
+
+    bool contains(const Key &key) const {
+        return count(key);
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args) {
+        Entry entry(std::forward<Args>(args)...);
+        std::uint32_t hash = compute_hash(get_key(entry));
+        std::size_t index = find_index(get_key(entry), hash);
+        if (index != slots.size()) {
+            return {iterator(this, index), false};
+        }
+        reserve_for_insertion();
+        index = place(std::move(entry), hash);
+        ++num_entries;
+        return {iterator(this, index), true};
+    }
+
+    std::pair<iterator, bool> insert(const Entry &entry) {
+        return emplace(entry);
+    }
+
+    std::pair<iterator, bool> insert(Entry &&entry) {
+        return emplace(std::move(entry));
+    }
+
+    /*
+      Unlike std::unordered_map::erase, this does not return an iterator:
+      erasing moves later entries of the probe sequence, which makes
+      iterating and erasing at the same time error-prone.
+    */
+    void erase(const_iterator it) {
+        assert(it.index < slots.size() && slots[it.index].distance);
+        erase_at(it.index);
+    }
+
+    std::size_t erase(const Key &key) {
+        std::size_t index = find_index(key, compute_hash(key));
+        if (index == slots.size()) {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+
+protected:
+    /*
+      Insert an entry for key constructed from key and args if the key is
+      not present yet. In contrast to emplace, this does not construct an
+      entry if the key is present.
+    */
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace_entry(const Key &key, Args &&...args) {
+        std::uint32_t hash = compute_hash(key);
+        std::size_t index = find_index(key, hash);
+        if (index != slots.size()) {
+            return {iterator(this, index), false};
+        }
+        reserve_for_insertion();
+        index = place(Entry(key, std::forward<Args>(args)...), hash);
+        ++num_entries;
+        return {iterator(this, index), true};
+    }
+};
+
+template<typename T1, typename T2>
+struct GetMapKey {
+    const T1 &operator()(const std::pair<T1, T2> &entry) const {
+        return entry.first;
+    }
+};
+
+template<typename T>
+struct GetSetKey {
+    const T &operator()(const T &entry) const {
+        return entry;
+    }
+};
+
+/*
+  Hash sets and hash maps for user code.
 
-  Use these aliases for hashing types T that don't have a standard std::hash<T>
-  specialization.
+  Use these for hashing types T that don't have a standard std::hash<T>
+  specialization. To hash types that are not supported out of the box,
+  implement utils::feed.
 
-  To hash types that are not supported out of the box, implement utils::feed.
+  The interfaces follow std::unordered_map and std::unordered_set, with the
+  following differences caused by the flat layout:
+
+  - Inserting or erasing entries invalidates all iterators, pointers and
+    references into the container.
+  - Map entries are std::pair<T1, T2> rather than std::pair<const T1, T2>.
+    Keys must not be modified through iterators.
+  - erase() does not return an iterator.
 */
 template<typename T1, typename T2>
-using HashMap = std::unordered_map<T1, T2, Hash<T1>>;
+class HashMap
+    : public OpenAddressingHashTable<T1, std::pair<T1, T2>, GetMapKey<T1, T2>> {
+    using Base =
+        OpenAddressingHashTable<T1, std::pair<T1, T2>, GetMapKey<T1, T2>>;
+public:
+    using key_type = T1;
+    using mapped_type = T2;
+    using value_type = std::pair<T1, T2>;
+
+    template<typename... Args>
+    std::pair<typename Base::iterator, bool> try_emplace(
+        const T1 &key, Args &&...args) {
+        return this->try_emplace_entry(
+            key, T2(std::forward<Args>(args)...));
+    }
+
+    T2 &operator[](const T1 &key) {
+        return try_emplace(key).first->second;
+    }
+
+    T2 &at(const T1 &key) {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("utils::HashMap::at");
+        }
+        return it->second;
+    }
+
+    const T2 &at(const T1 &key) const {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("utils::HashMap::at");
+        }
+        return it->second;
+    }
+};
 
 template<typename T>
-using HashSet = std::unordered_set<T, Hash<T>>;
+class HashSet : public OpenAddressingHashTable<T, T, GetSetKey<T>> {
+public:
+    using key_type = T;
+    using value_type = T;
+};
 }
 
 #endif
@@ -0,0 +1,167 @@
+#include "logging.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace utils {
+LogProxy g_log(Verbosity::NORMAL);
+
+namespace {
+const size_t max_pending_size = 1 << 16;
+const chrono::milliseconds max_write_delay(50);
+
+/*
+  Collects the output of all threads and writes it from a background
+  thread, either when enough output has accumulated or after a short delay.
+*/
+class AsyncLogSink {
+    mutex sink_mutex;
+    condition_variable output_available;
+    condition_variable output_written;
+    string pending_output;
+    long long num_submitted;
+    long long num_written;
+    long long flush_target;
+    bool stopping;
+    thread writer;
+
+    bool has_urgent_output() const {
+        return stopping || pending_output.size() >= max_pending_size ||
+               num_written < flush_target;
+    }
+
+    void write_output() {
+        string batch;
+        unique_lock<mutex> lock(sink_mutex);
+        while (true) {
+            output_available.wait_for(
+                lock, max_write_delay, [this] {return has_urgent_output();});
+            if (pending_output.empty()) {
+                if (stopping) {
+                    return;
+                }
+                continue;
+            }
+            batch.swap(pending_output);
+            long long num_batch_submitted = num_submitted;
+            lock.unlock();
+            cout.write(batch.data(), batch.size());
+            cout.flush();
+            batch.clear();
+            lock.lock();
+            num_written = num_batch_submitted;
+            output_written.notify_all();
+        }
+    }
+
+public:
+    AsyncLogSink()
+        : num_submitted(0),
+          num_written(0),
+          flush_target(0),
+          stopping(false),
+          writer([this] {write_output();}) {
+    }
+
+    ~AsyncLogSink() {
+        {
+            lock_guard<mutex> lock(sink_mutex);
+            stopping = true;
+        }
+        output_available.notify_one();
+        writer.join();
+    }
+
+    void submit(string_view output) {
+        bool notify;
+        {
+            lock_guard<mutex> lock(sink_mutex);
+            pending_output.append(output);
+            ++num_submitted;
+            notify = pending_output.size() >= max_pending_size;
+        }
+        if (notify) {
+            output_available.notify_one();
+        }
+    }
+
+    void flush() {
+        unique_lock<mutex> lock(sink_mutex);
+        flush_target = num_submitted;
+        output_available.notify_one();
+        output_written.wait(lock, [this] {return num_written >= flush_target;});
+    }
+};
+
+AsyncLogSink &get_sink() {
+    static AsyncLogSink sink;
+    return sink;
+}
+
+/*
+  Output of the current line. Complete lines are handed to the sink, so the
+  lines of different threads never interleave.
+*/
+struct ThreadLogBuffer {
+    string output;
+
+    ~ThreadLogBuffer() {
+        submit();
+    }
+
+    void submit() {
+        if (!output.empty()) {
+            get_sink().submit(output);
+            output.clear();
+        }
+    }
+};
+
+thread_local ThreadLogBuffer buffer;
+}
+
+namespace logging_internals {
+void append_text(string_view text) {
+    buffer.output.append(text);
+    if (!text.empty() && text.back() == '\n') {
+        buffer.submit();
+    }
+}
+
+void append_signed(long long value) {
+    char chars[24];
+    auto result = to_chars(begin(chars), end(chars), value);
+    buffer.output.append(chars, result.ptr);
+}
+
+void append_unsigned(unsigned long long value) {
+    char chars[24];
+    auto result = to_chars(begin(chars), end(chars), value);
+    buffer.output.append(chars, result.ptr);
+}
+
+void append_floating(double value) {
+    // Same format as the default of std::ostream.
+    char chars[32];
+    auto result =
+        to_chars(begin(chars), end(chars), value, chars_format::general, 6);
+    buffer.output.append(chars, result.ptr);
+}
+
+ostringstream &get_format_stream() {
+    thread_local ostringstream stream;
+    return stream;
+}
+}
+
+void flush_log() {
+    buffer.submit();
+    get_sink().flush();
+}
+}
@@ -1,6 +1,12 @@
 #ifndef UTILS_LOGGING_H
 #define UTILS_LOGGING_H
 
+#include <charconv>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 namespace utils {
 enum class Verbosity {
     SILENT,
@@ -8,6 +14,140 @@ enum class Verbosity {
     VERBOSE,
     DEBUG
 };
+
+/*
+  Messages above this verbosity are removed at compile time. Set it with
+  -DMAX_LOG_VERBOSITY=<n>, where n is the position of the level in
+  Verbosity (e.g. 1 for NORMAL).
+*/
+#ifndef MAX_LOG_VERBOSITY
+#define MAX_LOG_VERBOSITY 3
+#endif
+constexpr Verbosity max_log_verbosity =
+    static_cast<Verbosity>(MAX_LOG_VERBOSITY);
+
+/*
+  Log output is formatted into a buffer of the writing thread without
+  locking. Complete lines are handed to a background thread, which writes
+  them to stdout in batches, so logging never waits for I/O and lines of
+  different threads never interleave.
+*/
+namespace logging_internals {
+void append_text(std::string_view text);
+void append_signed(long long value);
+void append_unsigned(unsigned long long value);
+void append_floating(double value);
+std::ostringstream &get_format_stream();
+
+template<typename T>
+void append(const T &value) {
+    if constexpr (std::is_same_v<T, char>) {
+        append_text(std::string_view(&value, 1));
+    } else if constexpr (std::is_same_v<T, bool>) {
+        append_text(value ? "1" : "0");
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        append_signed(value);
+    } else if constexpr (std::is_integral_v<T>) {
+        append_unsigned(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        append_floating(value);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        append_text(std::string_view(value));
+    } else {
+        std::ostringstream &stream = get_format_stream();
+        stream.str("");
+        stream << value;
+        append_text(stream.view());
+    }
+}
+}
+
+/*
+  Stream for messages of one verbosity level. If the level is above
+  max_log_verbosity, all operations are empty and compile to nothing.
+*/
+template<Verbosity level>
+class LogStream {
+    bool enabled;
+public:
+    explicit LogStream(bool enabled) : enabled(enabled) {
+    }
+
+    template<typename T>
+    LogStream &operator<<(const T &value) {
+        if constexpr (level <= max_log_verbosity) {
+            if (enabled) {
+                logging_internals::append(value);
+            }
+        }
+        return *this;
+    }
+};
+
+/*
+  Each component has its own LogProxy with the verbosity it was configured
+  with. Streaming into the proxy writes a message at level NORMAL:
+
+    log << "Solution found!" << '\n';
+
+  Use verbose() and debug() for more detailed messages, and the
+  is_at_least_* functions to skip computing expensive messages.
+*/
+class LogProxy {
+    Verbosity verbosity;
+
+    template<Verbosity level>
+    bool is_at_least() const {
+        if constexpr (level > max_log_verbosity) {
+            return false;
+        } else {
+            return verbosity >= level;
+        }
+    }
+public:
+    explicit LogProxy(Verbosity verbosity) : verbosity(verbosity) {
+    }
+
+    Verbosity get_verbosity() const {
+        return verbosity;
+    }
+
+    bool is_at_least_normal() const {
+        return is_at_least<Verbosity::NORMAL>();
+    }
+
+    bool is_at_least_verbose() const {
+        return is_at_least<Verbosity::VERBOSE>();
+    }
+
+    bool is_at_least_debug() const {
+        return is_at_least<Verbosity::DEBUG>();
+    }
+
+    template<typename T>
+    LogStream<Verbosity::NORMAL> operator<<(const T &value) const {
+        LogStream<Verbosity::NORMAL> stream(is_at_least_normal());
+        stream << value;
+        return stream;
+    }
+
+    LogStream<Verbosity::VERBOSE> verbose() const {
+        return LogStream<Verbosity::VERBOSE>(is_at_least_verbose());
+    }
+
+    LogStream<Verbosity::DEBUG> debug() const {
+        return LogStream<Verbosity::DEBUG>(is_at_least_debug());
+    }
+};
+
+// Log for code that does not belong to a component.
+extern LogProxy g_log;
+
+/*
+  Hand over the buffered output of the calling thread and wait until all
+  output handed over so far is written.
+*/
+void flush_log();
 }
 
-#endif
\ No newline at end of file
+#endif
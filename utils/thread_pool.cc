@@ -0,0 +1,129 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace std;
+
+namespace utils {
+namespace {
+/*
+  State of one parallel_for call, shared by all threads that work on it.
+  Workers may pick up a helper task after the loop has finished, so the
+  state must outlive the call and must not touch body afterwards.
+*/
+struct ParallelLoop {
+    const function<void(size_t)> &body;
+    const size_t num_iterations;
+    atomic<size_t> next_iteration;
+
+    std::mutex finished_mutex;
+    condition_variable done;
+    size_t num_finished;
+    exception_ptr exception;
+
+    ParallelLoop(const function<void(size_t)> &body, size_t num_iterations)
+        : body(body),
+          num_iterations(num_iterations),
+          next_iteration(0),
+          num_finished(0) {
+    }
+
+    void run() {
+        while (true) {
+            size_t i = next_iteration.fetch_add(1, memory_order_relaxed);
+            if (i >= num_iterations) {
+                return;
+            }
+            exception_ptr error;
+            try {
+                body(i);
+            } catch (...) {
+                error = current_exception();
+            }
+            lock_guard<std::mutex> lock(finished_mutex);
+            if (error && !exception) {
+                exception = error;
+            }
+            if (++num_finished == num_iterations) {
+                done.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        unique_lock<std::mutex> lock(finished_mutex);
+        done.wait(lock, [this] {return num_finished == num_iterations;});
+        if (exception) {
+            rethrow_exception(exception);
+        }
+    }
+};
+}
+
+ThreadPool::ThreadPool(int num_workers)
+    : stopping(false) {
+    workers.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        workers.emplace_back([this] {work();});
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::work() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            task_available.wait(
+                lock, [this] {return stopping || !tasks.empty();});
+            if (tasks.empty()) {
+                return;
+            }
+            task = move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(move(task));
+    }
+    task_available.notify_one();
+}
+
+void ThreadPool::parallel_for(
+    size_t num_iterations, const function<void(size_t)> &body) {
+    if (num_iterations == 0) {
+        return;
+    }
+    if (num_iterations == 1 || workers.empty()) {
+        for (size_t i = 0; i < num_iterations; ++i) {
+            body(i);
+        }
+        return;
+    }
+    auto loop = make_shared<ParallelLoop>(body, num_iterations);
+    size_t num_helpers = min(num_iterations - 1, workers.size());
+    for (size_t i = 0; i < num_helpers; ++i) {
+        submit([loop] {loop->run();});
+    }
+    loop->run();
+    loop->wait();
+}
+}
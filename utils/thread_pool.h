@@ -0,0 +1,54 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed-size pool of worker threads for fork-join parallelism.
+
+  parallel_for is safe to call from inside a task of the same pool: the
+  calling thread always works on the loop itself, and it only waits for
+  iterations that other threads are already executing. Nested loops
+  therefore make progress even if all workers are busy, as long as the
+  iterations do not wait for each other in a cycle.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_available;
+    bool stopping;
+
+    void work();
+    void submit(std::function<void()> task);
+public:
+    // Create a pool with num_workers threads in addition to the caller.
+    explicit ThreadPool(int num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_workers() const {
+        return workers.size();
+    }
+
+    /*
+      Call body(i) for all i in [0, num_iterations) on the calling thread and
+      the workers, and return when all calls have finished. If calls throw,
+      the first exception is rethrown here after all calls have finished.
+    */
+    void parallel_for(
+        std::size_t num_iterations,
+        const std::function<void(std::size_t)> &body);
+};
+}
+
+#endif
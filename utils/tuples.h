@@ -1,28 +1,45 @@
 #ifndef UTILS_TUPLES_H
 #define UTILS_TUPLES_H
 
+#include <cstddef>
 #include <tuple>
+#include <utility>
 
 namespace utils {
-template<class... Ts, std::size_t... Is>
-auto flatten_tuple_elements(std::tuple<Ts...> &&t, std::index_sequence<Is...>);
+/*
+  Flatten nested tuples into a tuple of references to their non-tuple
+  elements, e.g. (a, (b, c)) into (a, b, c). The references keep the value
+  category of the elements, so elements of rvalue tuples can be moved from.
+  The result refers to the elements of the argument and must not outlive it.
+*/
+template<class Tuple, std::size_t... Is>
+auto flatten_tuple_elements(Tuple &&t, std::index_sequence<Is...>);
 
 template<class T>
 auto flatten_tuple(T &&t) {
-    return std::make_tuple(std::move(t));
+    return std::forward_as_tuple(std::forward<T>(t));
 }
 
 template<class... Ts>
 auto flatten_tuple(std::tuple<Ts...> &&t) {
-    constexpr std::size_t tuple_size =
-        std::tuple_size<std::tuple<Ts...>>::value;
     return flatten_tuple_elements(
-        std::move(t), std::make_index_sequence<tuple_size>());
+        std::move(t), std::index_sequence_for<Ts...>());
 }
 
-template<class... Ts, std::size_t... Is>
-auto flatten_tuple_elements(std::tuple<Ts...> &&t, std::index_sequence<Is...>) {
-    return std::tuple_cat(flatten_tuple(std::get<Is>(std::move(t)))...);
+template<class... Ts>
+auto flatten_tuple(std::tuple<Ts...> &t) {
+    return flatten_tuple_elements(t, std::index_sequence_for<Ts...>());
+}
+
+template<class... Ts>
+auto flatten_tuple(const std::tuple<Ts...> &t) {
+    return flatten_tuple_elements(t, std::index_sequence_for<Ts...>());
+}
+
+template<class Tuple, std::size_t... Is>
+auto flatten_tuple_elements(Tuple &&t, std::index_sequence<Is...>) {
+    return std::tuple_cat(
+        flatten_tuple(std::get<Is>(std::forward<Tuple>(t)))...);
 }
 
 template<typename T, typename Tuple>